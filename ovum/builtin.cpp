@@ -7,6 +7,10 @@
 namespace {
   using namespace egg::ovum;
 
+  const StringLiteral literalPredicate{ "predicate" };
+  const StringLiteral literalValue{ "value" };
+  const StringLiteral literalValues{ "values" };
+
   class BuiltinBase : public SoftReferenceCounted<IObject> {
     BuiltinBase(const BuiltinBase&) = delete;
     BuiltinBase& operator=(const BuiltinBase&) = delete;
@@ -121,7 +125,7 @@ namespace {
   public:
     explicit Builtin_Assert(IAllocator& allocator)
       : BuiltinFunction(allocator, "assert", Type::Void) {
-      this->type->addParameter("predicate", Type::Any, IFunctionSignatureParameter::Flags::Required);
+      this->type->addParameter(literalPredicate, Type::Any, IFunctionSignatureParameter::Flags::Required);
     }
     virtual Variant call(IExecution& execution, const IParameters& parameters) override {
       if (parameters.getNamedCount() > 0) {
@@ -140,7 +144,7 @@ namespace {
   public:
     explicit Builtin_Print(IAllocator& allocator)
       : BuiltinFunction(allocator, "print", Type::Void) {
-      this->type->addParameter("values", Type::Any, IFunctionSignatureParameter::Flags::Variadic);
+      this->type->addParameter(literalValues, Type::Any, IFunctionSignatureParameter::Flags::Variadic);
     }
     virtual Variant call(IExecution& execution, const IParameters& parameters) override {
       if (parameters.getNamedCount() > 0) {
@@ -182,7 +186,7 @@ namespace {
   public:
     explicit Builtin_TypeOf(IAllocator& allocator)
       : BuiltinFunction(allocator, "type.of", Type::Object) {
-      this->type->addParameter("value", Type::String, IFunctionSignatureParameter::Flags::Required);
+      this->type->addParameter(literalValue, Type::String, IFunctionSignatureParameter::Flags::Required);
     }
     virtual Variant call(IExecution& execution, const IParameters& parameters) override {
       if (parameters.getNamedCount() > 0) {
@@ -521,7 +525,7 @@ egg::ovum::Variant egg::ovum::VariantFactory::createStringProperty(IAllocator& a
     return Int(string.length());
   }
   // TODO optimize with lookup table
-#define EGG_STRING_PROPERTY(name) if (property == #name) return BuiltinStringFunction::make(allocator, "string." #name, &BuiltinStringFunction::name, string)
+#define EGG_STRING_PROPERTY(name) if (property.equals(#name)) { static const StringLiteral literal{ "string." #name }; return BuiltinStringFunction::make(allocator, literal, &BuiltinStringFunction::name, string); }
   EGG_STRING_PROPERTY(compareTo);
   EGG_STRING_PROPERTY(contains);
   EGG_STRING_PROPERTY(endsWith);
@@ -2,51 +2,173 @@ namespace egg::ovum {
   class MemoryFactory;
 
   struct AllocatorDefaultPolicy {
+    static constexpr bool accounting = true;
     inline static void* memalloc(size_t bytes, size_t alignment);
     inline static size_t memsize(void* allocated, size_t alignment);
     inline static void memfree(void* allocated, size_t);
   };
 
+  struct AllocatorUncountedPolicy : public AllocatorDefaultPolicy {
+    static constexpr bool accounting = false;
+  };
+
   // This often lives high up on the machine stack, so we need to know the class layout
   template<typename POLICY>
   class AllocatorWithPolicy : public IAllocator {
     AllocatorWithPolicy(const AllocatorWithPolicy&) = delete;
     AllocatorWithPolicy& operator=(const AllocatorWithPolicy&) = delete;
   private:
-    Atomic<uint64_t> allocatedBlocks;
-    Atomic<uint64_t> allocatedBytes;
-    Atomic<uint64_t> deallocatedBlocks;
-    Atomic<uint64_t> deallocatedBytes;
+    // Each thread updates its own cache line; the shards are only summed by statistics()
+    static constexpr size_t Shards = 16;
+    struct alignas(64) Shard {
+      std::atomic<uint64_t> allocatedBlocks{ 0 };
+      std::atomic<uint64_t> allocatedBytes{ 0 };
+      std::atomic<uint64_t> deallocatedBlocks{ 0 };
+      std::atomic<uint64_t> deallocatedBytes{ 0 };
+    };
+    std::atomic<Shard*> shards; // Allocated on the heap by the first allocation
   public:
-    AllocatorWithPolicy() : allocatedBlocks(0), allocatedBytes(0), deallocatedBlocks(0), deallocatedBytes(0) {}
+    AllocatorWithPolicy() : shards(nullptr) {}
+    virtual ~AllocatorWithPolicy() override {
+      delete[] this->shards.load(std::memory_order_acquire);
+    }
     virtual void* allocate(size_t bytes, size_t alignment) override {
       auto* allocated = POLICY::memalloc(bytes, alignment);
       assert(allocated != nullptr);
-      this->allocatedBlocks.add(1);
-      this->allocatedBytes.add(POLICY::memsize(allocated, alignment));
+      if constexpr (POLICY::accounting) {
+        auto& shard = this->shard();
+        shard.allocatedBlocks.fetch_add(1, std::memory_order_relaxed);
+        shard.allocatedBytes.fetch_add(POLICY::memsize(allocated, alignment), std::memory_order_relaxed);
+      }
       return allocated;
     }
     virtual void deallocate(void* allocated, size_t alignment) override {
       assert(allocated != nullptr);
-      this->deallocatedBlocks.add(1);
-      this->deallocatedBytes.add(POLICY::memsize(allocated, alignment));
+      if constexpr (POLICY::accounting) {
+        auto& shard = this->shard();
+        shard.deallocatedBlocks.fetch_add(1, std::memory_order_relaxed);
+        shard.deallocatedBytes.fetch_add(POLICY::memsize(allocated, alignment), std::memory_order_relaxed);
+      }
       POLICY::memfree(allocated, alignment);
     }
     virtual bool statistics(Statistics& out) const override {
-      out.totalBlocksAllocated = this->allocatedBlocks.get();
-      out.totalBytesAllocated = this->allocatedBytes.get();
-      out.currentBlocksAllocated = diff(out.totalBlocksAllocated, this->deallocatedBlocks.get());
-      out.currentBytesAllocated = diff(out.totalBytesAllocated, this->deallocatedBytes.get());
+      if constexpr (!POLICY::accounting) {
+        // Uncounted allocators never create their shards
+        (void)out;
+        return false;
+      }
+      out.totalBlocksAllocated = 0;
+      out.totalBytesAllocated = 0;
+      out.currentBlocksAllocated = 0;
+      out.currentBytesAllocated = 0;
+      auto* shards = this->shards.load(std::memory_order_acquire);
+      if (shards != nullptr) {
+        // Sum the deallocations first so that they are less likely to overtake the allocations
+        uint64_t deallocatedBlocks = 0;
+        uint64_t deallocatedBytes = 0;
+        for (size_t index = 0; index < Shards; ++index) {
+          deallocatedBlocks += shards[index].deallocatedBlocks.load(std::memory_order_acquire);
+          deallocatedBytes += shards[index].deallocatedBytes.load(std::memory_order_acquire);
+        }
+        for (size_t index = 0; index < Shards; ++index) {
+          out.totalBlocksAllocated += shards[index].allocatedBlocks.load(std::memory_order_acquire);
+          out.totalBytesAllocated += shards[index].allocatedBytes.load(std::memory_order_acquire);
+        }
+        out.currentBlocksAllocated = diff(out.totalBlocksAllocated, deallocatedBlocks);
+        out.currentBytesAllocated = diff(out.totalBytesAllocated, deallocatedBytes);
+      }
       return true;
     }
   private:
+    Shard& shard() {
+      auto* shards = this->shards.load(std::memory_order_acquire);
+      if (shards == nullptr) {
+        // Racing threads may both allocate the shards, but only one set is kept
+        auto* created = new Shard[Shards];
+        if (this->shards.compare_exchange_strong(shards, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+          shards = created;
+        } else {
+          delete[] created;
+        }
+      }
+      return shards[AllocatorWithPolicy::index()];
+    }
     static uint64_t diff(uint64_t a, uint64_t b) {
       // Disallow negative differences due to concurrency timing issues
       assert(a >= b);
       return (a < b) ? 0 : (a - b);
     }
+    static size_t index() {
+      // Threads are assigned shards round-robin on their first allocation
+      static std::atomic<size_t> next{ 0 };
+      thread_local size_t shard = next.fetch_add(1, std::memory_order_relaxed) % Shards;
+      return shard;
+    }
   };
   using AllocatorDefault = AllocatorWithPolicy<AllocatorDefaultPolicy>;
+  using AllocatorUncounted = AllocatorWithPolicy<AllocatorUncountedPolicy>;
+
+  // Bump allocator for short-lived trees: memory is only returned to the underlying allocator on destruction
+  class AllocatorArena : public IAllocator {
+    AllocatorArena(const AllocatorArena&) = delete;
+    AllocatorArena& operator=(const AllocatorArena&) = delete;
+  private:
+    struct Chunk {
+      Chunk* next;
+    };
+    IAllocator& underlying;
+    Chunk* chunks;
+    uint8_t* cursor;
+    uint8_t* limit;
+    uint64_t blocks;
+    uint64_t bytes;
+  public:
+    static constexpr size_t ChunkBytes = 0x10000;
+    explicit AllocatorArena(IAllocator& underlying)
+      : underlying(underlying), chunks(nullptr), cursor(nullptr), limit(nullptr), blocks(0), bytes(0) {
+    }
+    virtual ~AllocatorArena() override {
+      while (this->chunks != nullptr) {
+        auto* next = this->chunks->next;
+        this->underlying.deallocate(this->chunks, alignof(Chunk));
+        this->chunks = next;
+      }
+    }
+    virtual void* allocate(size_t bytes, size_t alignment) override {
+      // Not thread-safe: an arena should only be filled by a single thread
+      assert((alignment > 0) && ((alignment & (alignment - 1)) == 0));
+      if ((this->cursor == nullptr) || (size_t(this->limit - this->cursor) < bytes + alignment)) {
+        this->grow(bytes + alignment);
+      }
+      auto address = (uintptr_t(this->cursor) + alignment - 1) & ~uintptr_t(alignment - 1);
+      auto* allocated = reinterpret_cast<uint8_t*>(address);
+      assert(allocated + bytes <= this->limit);
+      this->cursor = allocated + bytes;
+      this->blocks++;
+      this->bytes += bytes;
+      return allocated;
+    }
+    virtual void deallocate(void*, size_t) override {
+      // Individual allocations are never reclaimed
+    }
+    virtual bool statistics(Statistics& out) const override {
+      out.totalBlocksAllocated = this->blocks;
+      out.totalBytesAllocated = this->bytes;
+      out.currentBlocksAllocated = this->blocks;
+      out.currentBytesAllocated = this->bytes;
+      return true;
+    }
+  private:
+    void grow(size_t minimum) {
+      auto payload = std::max(minimum, ChunkBytes - sizeof(Chunk));
+      auto* chunk = static_cast<Chunk*>(this->underlying.allocate(sizeof(Chunk) + payload, alignof(Chunk)));
+      assert(chunk != nullptr);
+      chunk->next = this->chunks;
+      this->chunks = chunk;
+      this->cursor = reinterpret_cast<uint8_t*>(chunk + 1);
+      this->limit = this->cursor + payload;
+    }
+  };
 
   class MemoryContiguous : public HardReferenceCounted<IMemory> {
     MemoryContiguous(const MemoryContiguous&) = delete;
@@ -176,7 +298,7 @@ namespace egg::ovum {
 
   class ObjectFactory {
   public:
-    static Object createVanillaArray(IAllocator& allocator, size_t size = 0);
+    static Object createVanillaArray(IAllocator& allocator, IBasket& basket, std::vector<Variant>&& elements = {});
     static Object createVanillaException(IAllocator& allocator, const LocationSource& location, const String& message);
     static Object createVanillaKeyValue(IAllocator& allocator, IBasket& basket, const Variant& key, const Variant& value);
     static Object createVanillaObject(IAllocator& allocator);
@@ -16,8 +16,8 @@ namespace {
     virtual Variant getPositional(size_t) const override {
       return Variant::Void;
     }
-    virtual const LocationSource* getPositionalLocation(size_t) const override {
-      return nullptr;
+    virtual bool getPositionalLocation(size_t, LocationSource&) const override {
+      return false;
     }
     virtual size_t getNamedCount() const override {
       return 0;
@@ -28,8 +28,8 @@ namespace {
     virtual Variant getNamed(const String&) const override {
       return Variant::Void;
     }
-    virtual const LocationSource* getNamedLocation(const String&) const override {
-      return nullptr;
+    virtual bool getNamedLocation(const String&, LocationSource&) const override {
+      return false;
     }
   };
   const ParametersNone parametersNone{};
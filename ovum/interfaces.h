@@ -123,11 +123,11 @@ namespace egg::ovum {
     virtual ~IParameters() {}
     virtual size_t getPositionalCount() const = 0;
     virtual Variant getPositional(size_t index) const = 0;
-    virtual const LocationSource* getPositionalLocation(size_t index) const = 0; // May return null
+    virtual bool getPositionalLocation(size_t index, LocationSource& location) const = 0; // Returns false if unknown
     virtual size_t getNamedCount() const = 0;
     virtual String getName(size_t index) const = 0;
     virtual Variant getNamed(const String& name) const = 0;
-    virtual const LocationSource* getNamedLocation(const String& name) const = 0; // May return null
+    virtual bool getNamedLocation(const String& name, LocationSource& location) const = 0; // Returns false if unknown
   };
 
   class IFunctionSignatureParameter {
@@ -199,4 +199,11 @@ namespace egg::ovum {
     virtual Variant setIndex(IExecution& execution, const Variant& index, const Variant& value) = 0;
     virtual Variant iterate(IExecution& execution) = 0;
   };
+
+  class IIndexedIterable {
+  public:
+    // Implemented by built-in containers so that 'for' loops need not create an iterator object
+    virtual ~IIndexedIterable() {}
+    virtual bool iterateIndex(IExecution& execution, size_t index, Variant& element) = 0;
+  };
 }
@@ -630,7 +630,7 @@ namespace {
     ModuleDefault& operator=(const ModuleDefault&) = delete;
   private:
     String resource;
-    Node root;
+    Node root; // Counts the whole tree once frozen
   public:
     ModuleDefault(IAllocator& allocator, const String& resource, INode* root = nullptr)
       : HardReferenceCounted(allocator, 0),
@@ -651,6 +651,10 @@ namespace {
       this->root = reader.read();
       assert(this->root != nullptr);
     }
+    void freeze() {
+      assert(this->root != nullptr);
+      this->root->freeze();
+    }
   };
 }
 
@@ -688,19 +692,26 @@ std::string egg::ovum::OperatorProperties::str(Operator oper) {
   return "<unknown:" + std::to_string(int(oper)) + ">";
 }
 
-egg::ovum::Module egg::ovum::ModuleFactory::fromBinaryStream(IAllocator& allocator, const String& resource, std::istream& stream) {
+egg::ovum::Module egg::ovum::ModuleFactory::fromBinaryStream(IAllocator& allocator, const String& resource, std::istream& stream, Sharing sharing) {
   auto module = allocator.make<ModuleDefault>(resource);
   module->readFromStream(stream);
+  if (sharing == Sharing::Frozen) {
+    module->freeze();
+  }
   return Module(module.get());
 }
 
-egg::ovum::Module egg::ovum::ModuleFactory::fromMemory(IAllocator& allocator, const String& resource, const uint8_t* begin, const uint8_t* end) {
+egg::ovum::Module egg::ovum::ModuleFactory::fromMemory(IAllocator& allocator, const String& resource, const uint8_t* begin, const uint8_t* end, Sharing sharing) {
   MemoryStream stream(begin, end);
-  return ModuleFactory::fromBinaryStream(allocator, resource, stream);
+  return ModuleFactory::fromBinaryStream(allocator, resource, stream, sharing);
 }
 
-egg::ovum::Module egg::ovum::ModuleFactory::fromRootNode(IAllocator& allocator, const String& resource, INode& root) {
-  return allocator.make<ModuleDefault, Module>(resource, &root);
+egg::ovum::Module egg::ovum::ModuleFactory::fromRootNode(IAllocator& allocator, const String& resource, INode& root, Sharing sharing) {
+  auto module = allocator.make<ModuleDefault>(resource, &root);
+  if (sharing == Sharing::Frozen) {
+    module->freeze();
+  }
+  return Module(module.get());
 }
 
 void egg::ovum::ModuleFactory::toBinaryStream(const IModule& module, std::ostream& stream) {
@@ -28,9 +28,11 @@ namespace egg::ovum {
 
   class ModuleFactory {
   public:
-    static Module fromBinaryStream(IAllocator& allocator, const String& resource, std::istream& stream);
-    static Module fromMemory(IAllocator& allocator, const String& resource, const uint8_t* begin, const uint8_t* end);
-    static Module fromRootNode(IAllocator& allocator, const String& resource, INode& root);
+    // Frozen modules are immutable so may be executed concurrently; their node tree is counted as a whole, not per node
+    enum class Sharing { Counted, Frozen };
+    static Module fromBinaryStream(IAllocator& allocator, const String& resource, std::istream& stream, Sharing sharing = Sharing::Counted);
+    static Module fromMemory(IAllocator& allocator, const String& resource, const uint8_t* begin, const uint8_t* end, Sharing sharing = Sharing::Counted);
+    static Module fromRootNode(IAllocator& allocator, const String& resource, INode& root, Sharing sharing = Sharing::Counted);
     static void toBinaryStream(const IModule& module, std::ostream& stream);
     static Memory toMemory(IAllocator& allocator, const IModule& module);
   };
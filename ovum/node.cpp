@@ -6,19 +6,150 @@
 namespace {
   using namespace egg::ovum;
 
+  class NodeTree;
+
+  class NodeCounted : public HardReferenceCounted<INode> {
+    NodeCounted(const NodeCounted&) = delete;
+    NodeCounted& operator=(const NodeCounted&) = delete;
+  protected:
+    std::atomic<NodeTree*> tree; // Frozen nodes count handles on their tree rather than on themselves
+    mutable std::atomic<uint8_t> proof;
+  public:
+    explicit NodeCounted(IAllocator& allocator)
+      : HardReferenceCounted(allocator, 0),
+        tree(nullptr),
+        proof(0) {
+    }
+    virtual ~NodeCounted() {
+      assert(this->tree.load() == nullptr);
+    }
+    virtual INode* hardAcquire() const override;
+    virtual void hardRelease() const override;
+    virtual bool isFrozen() const override {
+      return this->tree.load(std::memory_order_acquire) != nullptr;
+    }
+    virtual void freeze() override;
+    virtual uint8_t getProofCache() const override {
+      // Frozen nodes were resolved when frozen, so threads sharing them only ever read this
+      return this->proof.load(std::memory_order_relaxed);
+    }
+    virtual void setProofCache(uint8_t value) const override {
+      if (!this->isFrozen()) {
+        this->proof.store(value, std::memory_order_relaxed);
+      }
+    }
+    void adopt(NodeTree& owner, int64_t& handles);
+    void release(NodeTree& owner);
+  private:
+    NodeCounted& link(size_t index) const {
+      // Every node is created by NodeFactory, so all links are to our own kind
+      auto n = this->getChildren();
+      return static_cast<NodeCounted&>((index < n) ? this->getChild(index) : this->getAttribute(index - n));
+    }
+  };
+
+  class NodeTree final : public HardReferenceCounted<IHardAcquireRelease> {
+    NodeTree(const NodeTree&) = delete;
+    NodeTree& operator=(const NodeTree&) = delete;
+  private:
+    NodeCounted& root;
+  public:
+    NodeTree(IAllocator& allocator, NodeCounted& root)
+      : HardReferenceCounted(allocator, 0),
+        root(root) {
+    }
+    virtual ~NodeTree() override {
+      // The last handle has gone, so hand the nodes back their own counts and tear them down as usual
+      this->root.release(*this);
+      this->root.hardAcquire();
+      this->root.hardRelease();
+    }
+    void adopt(int64_t handles) {
+      assert(handles > 0);
+      this->atomic.add(handles);
+    }
+  };
+
+  INode* NodeCounted::hardAcquire() const {
+    auto* owner = this->tree.load(std::memory_order_relaxed);
+    if (owner != nullptr) {
+      owner->hardAcquire();
+      return const_cast<NodeCounted*>(this);
+    }
+    return HardReferenceCounted::hardAcquire();
+  }
+
+  void NodeCounted::hardRelease() const {
+    auto* owner = this->tree.load(std::memory_order_relaxed);
+    if (owner != nullptr) {
+      owner->hardRelease();
+    } else {
+      HardReferenceCounted::hardRelease();
+    }
+  }
+
+  void NodeCounted::freeze() {
+    // Trees must be frozen before they are shared; a tree already frozen by another module is simply shared
+    if (this->tree.load() == nullptr) {
+      auto* owner = this->allocator.create<NodeTree>(0, this->allocator, *this);
+      int64_t handles = 0;
+      this->adopt(*owner, handles);
+      owner->adopt(handles);
+    }
+  }
+
+  void NodeCounted::adopt(NodeTree& owner, int64_t& handles) {
+    // Move the handles held on this node onto the tree; only links within the tree stay counted on the node
+    handles += this->atomic.get();
+    this->atomic.add(-this->atomic.get());
+    this->tree.store(&owner, std::memory_order_release);
+    this->proof.store(Node::isProven(*this) ? ProofCache::Proven : ProofCache::Checked, std::memory_order_relaxed);
+    auto n = this->getChildren() + this->getAttributes();
+    for (size_t i = 0; i < n; ++i) {
+      auto& target = this->link(i);
+      auto* frozen = target.tree.load();
+      if (frozen == nullptr) {
+        // Each node is visited once, however many parents share it
+        target.adopt(owner, handles);
+        frozen = &owner;
+      }
+      if (frozen == &owner) {
+        target.atomic.increment();
+        handles--;
+      }
+      // Links into another frozen tree already count that tree
+    }
+  }
+
+  void NodeCounted::release(NodeTree& owner) {
+    if (this->tree.load() == &owner) {
+      this->tree.store(nullptr);
+      auto n = this->getChildren() + this->getAttributes();
+      for (size_t i = 0; i < n; ++i) {
+        this->link(i).release(owner);
+      }
+    }
+  }
+
   template<typename EXTRA>
-  class NodeContiguous final : public HardReferenceCounted<INode> {
+  class NodeContiguous final : public NodeCounted {
     NodeContiguous(const NodeContiguous&) = delete;
     NodeContiguous& operator=(const NodeContiguous&) = delete;
   private:
     Opcode opcode;
+    mutable std::atomic<const IHardAcquireRelease*> cache;
   public:
     NodeContiguous(IAllocator& allocator, Opcode opcode, typename EXTRA::Type operand)
-      : HardReferenceCounted(allocator, 0),
-        opcode(opcode) {
+      : NodeCounted(allocator),
+        opcode(opcode),
+        cache(nullptr) {
       new(this->extra()) EXTRA(operand);
     }
     virtual ~NodeContiguous() {
+      auto* cached = this->cache.load();
+      if (cached != nullptr) {
+        cached->hardRelease();
+      }
       this->extra()->~EXTRA();
     }
     virtual Opcode getOpcode() const override {
@@ -64,6 +195,9 @@ namespace {
       if (index >= this->extra()->children) {
         throw std::out_of_range("Invalid AST node child index");
       }
+      if (this->isFrozen()) {
+        throw std::logic_error("Cannot modify a frozen AST node");
+      }
       auto& slot = (this->extra()->base)[index];
       auto* before = slot;
       slot = HardPtr<INode>::hardAcquire(&value);
@@ -71,6 +205,18 @@ namespace {
         before->hardRelease();
       }
     }
+    virtual const IHardAcquireRelease& getCache(const CacheFactory& factory) const override {
+      auto* cached = this->cache.load(std::memory_order_acquire);
+      if (cached == nullptr) {
+        // Threads sharing a frozen tree may race to build the cache, so only the first one is kept
+        auto* created = factory(this->allocator)->hardAcquire();
+        if (this->cache.compare_exchange_strong(cached, created, std::memory_order_acq_rel)) {
+          return *created;
+        }
+        created->hardRelease();
+      }
+      return *cached;
+    }
     void initChild(size_t index, const Node& node) {
       assert(index < this->extra()->children);
       this->extra()->base[index] = node.hardAcquire();
@@ -644,6 +790,17 @@ egg::ovum::Node egg::ovum::NodeFactory::createFunctionType(IAllocator& allocator
   return NodeFactory::create(allocator, location, OPCODE_OBJECT, &children);
 }
 
+bool egg::ovum::Node::isProven(const INode& node) {
+  auto n = node.getAttributes();
+  for (size_t i = 0; i < n; ++i) {
+    auto& attribute = node.getAttribute(i);
+    if ((attribute.getChild(0).getString().equals(Node::AttributeProven)) && (attribute.getChild(1).getOpcode() == OPCODE_TRUE)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 egg::ovum::String egg::ovum::Node::toString(const INode* node) {
   StringBuilder sb;
   buildNodeString(sb, node);
@@ -38,10 +38,29 @@ namespace egg::ovum {
     virtual INode& getAttribute(size_t index) const = 0;
     virtual const NodeLocation* getLocation() const = 0;
     virtual void setChild(size_t index, INode& value) = 0;
+    // Frozen trees are immutable and count handles to any of their nodes as a whole (see ModuleFactory::Sharing)
+    virtual bool isFrozen() const = 0;
+    virtual void freeze() = 0;
+    // Interpreter's cached lookup of the compiler's type proof attribute; zero until looked up, resolved when frozen (never serialized)
+    virtual uint8_t getProofCache() const = 0;
+    virtual void setProofCache(uint8_t value) const = 0;
+    // Opaque runtime state built by the interpreter on first use and released with the node (never serialized)
+    using CacheFactory = std::function<IHardAcquireRelease*(IAllocator& allocator)>;
+    virtual const IHardAcquireRelease& getCache(const CacheFactory& factory) const = 0;
+  };
+
+  class ProofCache {
+  public:
+    // Values of INode::getProofCache() once the proof attribute has been looked up
+    static constexpr uint8_t Checked = 0x01;
+    static constexpr uint8_t Proven = 0x02;
   };
 
   class Node : public HardPtr<INode> {
   public:
+    // Attribute added by the compiler when an assigned value is statically known to suit its target
+    static constexpr char AttributeProven[] = "proven";
+    static bool isProven(const INode& node);
     Node(std::nullptr_t = nullptr) {} // implicit
     explicit Node(const INode* node) : HardPtr(node) {}
     String toString() const {
@@ -0,0 +1,348 @@
+namespace egg::ovum {
+  // Integer kernels with defined two's complement wrapping: they return false if the result overflowed
+  class IntArithmetic {
+  public:
+    static bool add(Int a, Int b, Int& result) {
+#if defined(__GNUC__)
+      return !__builtin_add_overflow(a, b, &result);
+#else
+      result = Int(uint64_t(a) + uint64_t(b));
+      return ((a ^ result) & (b ^ result)) >= 0;
+#endif
+    }
+    static bool sub(Int a, Int b, Int& result) {
+#if defined(__GNUC__)
+      return !__builtin_sub_overflow(a, b, &result);
+#else
+      result = Int(uint64_t(a) - uint64_t(b));
+      return ((a ^ b) & (a ^ result)) >= 0;
+#endif
+    }
+    static bool mul(Int a, Int b, Int& result) {
+#if defined(__GNUC__)
+      return !__builtin_mul_overflow(a, b, &result);
+#else
+      result = Int(uint64_t(a) * uint64_t(b));
+      if ((a == -1) && (b == std::numeric_limits<Int>::min())) {
+        return false;
+      }
+      return (a == 0) || ((result / a) == b);
+#endif
+    }
+    static bool div(Int a, Int b, Int& result) {
+      // The caller must check for division by zero
+      assert(b != 0);
+      if ((b == -1) && (a == std::numeric_limits<Int>::min())) {
+        result = a;
+        return false;
+      }
+      result = a / b;
+      return true;
+    }
+    static bool rem(Int a, Int b, Int& result) {
+      // The caller must check for division by zero
+      assert(b != 0);
+      result = (b == -1) ? 0 : (a % b);
+      return true;
+    }
+  };
+
+  // Binary operator semantics shared by the interpreter and the optimizer
+  class Binary {
+  public:
+    enum class Match { Bool, Int, Float, Mismatch };
+    static Variant apply(Operator oper, Variant& lvalue, const Variant& rvalue) {
+      // Returns 'Break' if operator not known
+      if (lvalue.isInt() && rvalue.isInt()) {
+        auto fast = Binary::applyInt(oper, lvalue, rvalue.getInt());
+        if (!fast.is(VariantBits::Break)) {
+          return fast;
+        }
+      } else if (lvalue.isFloat() && rvalue.isFloat()) {
+        if (Binary::applyFloat(oper, lvalue, rvalue.getFloat())) {
+          return Variant::Void;
+        }
+      }
+      // Arithmetic between two 'int' values never reaches the generic path below
+      auto retval = Variant::Break;
+      Float lfloat, rfloat;
+      uint64_t uvalue;
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (oper) {
+      case OPERATOR_ADD:
+        switch (Binary::arithmetic("addition", lvalue, rvalue, lfloat, rfloat, retval)) {
+        case Match::Float:
+          lvalue = lfloat + rfloat;
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_SUB:
+        switch (Binary::arithmetic("subtraction", lvalue, rvalue, lfloat, rfloat, retval)) {
+        case Match::Float:
+          lvalue = lfloat - rfloat;
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_MUL:
+        switch (Binary::arithmetic("multiplication", lvalue, rvalue, lfloat, rfloat, retval)) {
+        case Match::Float:
+          lvalue = lfloat * rfloat;
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_DIV:
+        switch (Binary::arithmetic("division", lvalue, rvalue, lfloat, rfloat, retval)) {
+        case Match::Float:
+          lvalue = lfloat / rfloat;
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_REM:
+        switch (Binary::arithmetic("remainder", lvalue, rvalue, lfloat, rfloat, retval)) {
+        case Match::Float:
+          lvalue = std::remainder(lfloat, rfloat);
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_BITAND:
+        switch (Binary::bitwise("bitwise-and", lvalue, rvalue, retval)) {
+        case Match::Int:
+          lvalue = lvalue.getInt() & rvalue.getInt();
+          return Variant::Void;
+        case Match::Bool:
+          lvalue = lvalue.getBool() && rvalue.getBool();
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_BITOR:
+        switch (Binary::bitwise("bitwise-or", lvalue, rvalue, retval)) {
+        case Match::Int:
+          lvalue = lvalue.getInt() | rvalue.getInt();
+          return Variant::Void;
+        case Match::Bool:
+          lvalue = lvalue.getBool() || rvalue.getBool();
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_BITXOR:
+        switch (Binary::bitwise("bitwise-xor", lvalue, rvalue, retval)) {
+        case Match::Int:
+          lvalue = lvalue.getInt() ^ rvalue.getInt();
+          return Variant::Void;
+        case Match::Bool:
+          lvalue = bool(lvalue.getBool() ^ rvalue.getBool());
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_LOGAND:
+        // Note that short-circuiting is handled previously in Target::apply()
+        switch (Binary::logical("logical-and", lvalue, rvalue, retval)) {
+        case Match::Bool:
+          lvalue = lvalue.getBool() && rvalue.getBool();
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_LOGOR:
+        // Note that short-circuiting is handled previously in Target::apply()
+        switch (Binary::logical("logical-or", lvalue, rvalue, retval)) {
+        case Match::Bool:
+          lvalue = lvalue.getBool() || rvalue.getBool();
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_SHIFTL:
+        switch (Binary::shift("left-shift", lvalue, rvalue, uvalue, retval)) {
+        case Match::Int:
+          lvalue = lvalue.getInt() << uvalue;
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_SHIFTR:
+        switch (Binary::shift("right-shift", lvalue, rvalue, uvalue, retval)) {
+        case Match::Int:
+          lvalue = lvalue.getInt() >> uvalue;
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_SHIFTU:
+        switch (Binary::shift("unsigned-right-shift", lvalue, rvalue, uvalue, retval)) {
+        case Match::Int:
+          lvalue = Int(uint64_t(lvalue.getInt()) >> uvalue);
+          return Variant::Void;
+        }
+        break;
+      case OPERATOR_IFNULL:
+        if (lvalue.isNull()) {
+          lvalue = rvalue;
+        }
+        return Variant::Void;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      return retval;
+    }
+    static Variant applyInt(Operator oper, Variant& lvalue, Int rvalue) {
+      // Update an 'int' in place; returns 'Break' to defer to the generic path
+      auto lhs = lvalue.getInt();
+      Int result;
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (oper) {
+      case OPERATOR_ADD:
+        if (!IntArithmetic::add(lhs, rvalue, result)) {
+          return Binary::raise("Integer overflow in addition");
+        }
+        break;
+      case OPERATOR_SUB:
+        if (!IntArithmetic::sub(lhs, rvalue, result)) {
+          return Binary::raise("Integer overflow in subtraction");
+        }
+        break;
+      case OPERATOR_MUL:
+        if (!IntArithmetic::mul(lhs, rvalue, result)) {
+          return Binary::raise("Integer overflow in multiplication");
+        }
+        break;
+      case OPERATOR_DIV:
+        if (rvalue == 0) {
+          return Binary::raise("Division by zero in integer division");
+        }
+        if (!IntArithmetic::div(lhs, rvalue, result)) {
+          return Binary::raise("Integer overflow in division");
+        }
+        break;
+      case OPERATOR_REM:
+        if (rvalue == 0) {
+          return Binary::raise("Division by zero in integer remainder");
+        }
+        IntArithmetic::rem(lhs, rvalue, result);
+        break;
+      case OPERATOR_BITAND:
+        result = lhs & rvalue;
+        break;
+      case OPERATOR_BITOR:
+        result = lhs | rvalue;
+        break;
+      case OPERATOR_BITXOR:
+        result = lhs ^ rvalue;
+        break;
+      default:
+        return Variant::Break;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      lvalue.setInt(result);
+      return Variant::Void;
+    }
+    static bool applyFloat(Operator oper, Variant& lvalue, Float rvalue) {
+      // Update a 'float' in place; returns false to defer to the generic path
+      auto lhs = lvalue.getFloat();
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (oper) {
+      case OPERATOR_ADD:
+        lvalue.setFloat(lhs + rvalue);
+        return true;
+      case OPERATOR_SUB:
+        lvalue.setFloat(lhs - rvalue);
+        return true;
+      case OPERATOR_MUL:
+        lvalue.setFloat(lhs * rvalue);
+        return true;
+      case OPERATOR_DIV:
+        lvalue.setFloat(lhs / rvalue);
+        return true;
+      case OPERATOR_REM:
+        lvalue.setFloat(std::remainder(lhs, rvalue));
+        return true;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      return false;
+    }
+    static Match arithmetic(const char* operation, const Variant& a, const Variant& b, Float& fa, Float& fb, Variant& retval) {
+      // Promote integers to floats where appropriate
+      if (a.isFloat()) {
+        if (b.isFloat()) {
+          fa = a.getFloat();
+          fb = b.getFloat();
+          return Match::Float;
+        } else if (b.isInt()) {
+          // TODO overflow
+          fa = a.getFloat();
+          fb = Float(b.getInt());
+          return Match::Float;
+        }
+        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int' or 'float'");
+        return Match::Mismatch;
+      }
+      if (a.isInt()) {
+        if (b.isFloat()) {
+          // TODO overflow
+          fa = Float(a.getInt());
+          fb = b.getFloat();
+          return Match::Float;
+        } else if (b.isInt()) {
+          return Match::Int;
+        }
+        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int' or 'float'");
+        return Match::Mismatch;
+      }
+      retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be an 'int' or 'float'");
+      return Match::Mismatch;
+    }
+    static Match bitwise(const char* operation, const Variant& a, const Variant& b, Variant& retval) {
+      // Accept matching ints or bools
+      if (a.isInt()) {
+        if (b.isInt()) {
+          return Match::Int;
+        }
+        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int'");
+        return Match::Mismatch;
+      }
+      if (a.isBool()) {
+        if (b.isBool()) {
+          return Match::Bool;
+        }
+        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be a 'bool'");
+        return Match::Mismatch;
+      }
+      retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be a 'bool' or 'int'");
+      return Match::Mismatch;
+    }
+    static Match logical(const char* operation, const Variant& a, const Variant& b, Variant& retval) {
+      // Accept only bools
+      if (!a.isBool()) {
+        retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be a 'bool'");
+        return Match::Mismatch;
+      }
+      if (!b.isBool()) {
+        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be a 'bool'");
+        return Match::Mismatch;
+      }
+      return Match::Bool;
+    }
+    static Match shift(const char* operation, const Variant& a, const Variant& b, uint64_t& ub, Variant& retval) {
+      // Accept only bools
+      if (!a.isInt()) {
+        retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be an 'int'");
+        return Match::Mismatch;
+      }
+      if (!b.isInt()) {
+        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int'");
+        return Match::Mismatch;
+      }
+      auto ib = b.getInt();
+      if (ib < 0) {
+        retval = Binary::raise("Expected right-hand side of ", operation, " to be a non-negative 'int', but got ", std::to_string(ib), " instead");
+        return Match::Mismatch;
+      }
+      ub = uint64_t(ib);
+      return Match::Int;
+    }
+    template<typename... ARGS>
+    static Variant unexpected(const Variant& value, ARGS&&... args) {
+      return Binary::raise(std::forward<ARGS>(args)..., ", but got '", value.getRuntimeType().toString(), "' instead");
+    }
+    template<typename... ARGS>
+    static Variant raise(ARGS&&... args) {
+      Variant exception{ StringBuilder::concat(std::forward<ARGS>(args)...) };
+      return VariantFactory::createException(std::move(exception));
+    }
+  };
+}
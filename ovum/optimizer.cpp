@@ -0,0 +1,242 @@
+#include "ovum/ovum.h"
+#include "ovum/node.h"
+#include "ovum/operators.h"
+#include "ovum/optimizer.h"
+
+namespace {
+  using namespace egg::ovum;
+
+  class OptimizerDefault final {
+    OptimizerDefault(const OptimizerDefault&) = delete;
+    OptimizerDefault& operator=(const OptimizerDefault&) = delete;
+  private:
+    IAllocator& allocator;
+  public:
+    explicit OptimizerDefault(IAllocator& allocator)
+      : allocator(allocator) {
+    }
+    Node optimize(const Node& node) {
+      assert(node != nullptr);
+      auto n = node->getChildren();
+      Nodes children;
+      children.reserve(n);
+      bool changed = false;
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (node->getOpcode()) {
+      case OPCODE_BLOCK:
+        changed = this->optimizeBlock(*node, children);
+        break;
+      case OPCODE_IF:
+        changed = this->optimizeIf(*node, children);
+        break;
+      default:
+        for (size_t i = 0; i < n; ++i) {
+          Node before{ &node->getChild(i) };
+          children.push_back(this->optimize(before));
+          changed |= (children.back().get() != before.get());
+        }
+        break;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      if (changed) {
+        return this->fold(this->rebuild(*node, children));
+      }
+      return this->fold(node);
+    }
+  private:
+    bool optimizeBlock(const INode& block, Nodes& children) {
+      // Statements that can never have an effect are removed altogether
+      auto n = block.getChildren();
+      Node noop;
+      bool changed = false;
+      for (size_t i = 0; i < n; ++i) {
+        Node before{ &block.getChild(i) };
+        auto after = this->prune(this->optimize(before));
+        if (after == nullptr) {
+          if ((noop == nullptr) && (before->getOpcode() == OPCODE_NOOP)) {
+            noop = before;
+          }
+          changed = true;
+        } else {
+          changed |= (after.get() != before.get());
+          children.push_back(std::move(after));
+        }
+      }
+      if (children.empty()) {
+        // Blocks must have at least one statement
+        if (noop == nullptr) {
+          children.push_back(NodeFactory::create(this->allocator, OPCODE_NOOP));
+        } else if (n == 1) {
+          return false;
+        } else {
+          children.push_back(noop);
+        }
+      }
+      return changed;
+    }
+    bool optimizeIf(const INode& node, Nodes& children) {
+      // The 'else' clause of an 'if' statement is either a block or another 'if' statement
+      auto n = node.getChildren();
+      assert((n == 2) || (n == 3));
+      bool changed = false;
+      for (size_t i = 0; i < n; ++i) {
+        Node before{ &node.getChild(i) };
+        auto after = this->optimize(before);
+        if (i == 2) {
+          after = this->prune(after);
+          if (after == nullptr) {
+            // Drop the 'else' clause entirely
+            return true;
+          }
+        }
+        changed |= (after.get() != before.get());
+        children.push_back(std::move(after));
+      }
+      return changed;
+    }
+    Node prune(const Node& statement) {
+      // Returns null if the statement can be removed
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (statement->getOpcode()) {
+      case OPCODE_NOOP:
+        return nullptr;
+      case OPCODE_IF:
+        switch (statement->getChild(0).getOpcode()) {
+        case OPCODE_TRUE:
+          return Node(&statement->getChild(1));
+        case OPCODE_FALSE:
+          if (statement->getChildren() == 3) {
+            return this->prune(Node(&statement->getChild(2)));
+          }
+          return nullptr;
+        }
+        break;
+      case OPCODE_WHILE:
+        if (statement->getChild(0).getOpcode() == OPCODE_FALSE) {
+          return nullptr;
+        }
+        break;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      return statement;
+    }
+    Node fold(const Node& expression) {
+      // Returns the original expression if it cannot be folded
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (expression->getOpcode()) {
+      case OPCODE_UNARY:
+        if (OptimizerDefault::oper(*expression) == OPERATOR_LOGNOT) {
+          switch (expression->getChild(0).getOpcode()) {
+          case OPCODE_TRUE:
+            return this->create(expression->getLocation(), OPCODE_FALSE, nullptr);
+          case OPCODE_FALSE:
+            return this->create(expression->getLocation(), OPCODE_TRUE, nullptr);
+          }
+        }
+        break;
+      case OPCODE_BINARY:
+        return this->foldBinary(expression);
+      case OPCODE_TERNARY:
+        switch (expression->getChild(0).getOpcode()) {
+        case OPCODE_TRUE:
+          return Node(&expression->getChild(1));
+        case OPCODE_FALSE:
+          return Node(&expression->getChild(2));
+        }
+        break;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      return expression;
+    }
+    Node foldBinary(const Node& expression) {
+      // Only fold the arithmetic operators supported by the interpreter
+      auto oper = OptimizerDefault::oper(*expression);
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (oper) {
+      case OPERATOR_ADD:
+      case OPERATOR_SUB:
+      case OPERATOR_MUL:
+      case OPERATOR_DIV:
+      case OPERATOR_REM:
+        break;
+      default:
+        return expression;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      Variant lhs, rhs;
+      if (!OptimizerDefault::literal(expression->getChild(0), lhs) || !OptimizerDefault::literal(expression->getChild(1), rhs)) {
+        return expression;
+      }
+      if (lhs.isInt() && rhs.isInt() && ((oper == OPERATOR_DIV) || (oper == OPERATOR_REM))) {
+        // Leave integer division traps to the interpreter
+        auto divisor = rhs.getInt();
+        if ((divisor == 0) || ((divisor == -1) && (lhs.getInt() == std::numeric_limits<Int>::min()))) {
+          return expression;
+        }
+      }
+      if (!Binary::apply(oper, lhs, rhs).isVoid()) {
+        return expression;
+      }
+      if (lhs.isInt()) {
+        return this->create(expression->getLocation(), OPCODE_IVALUE, nullptr, nullptr, lhs.getInt());
+      }
+      assert(lhs.isFloat());
+      return this->create(expression->getLocation(), OPCODE_FVALUE, nullptr, nullptr, lhs.getFloat());
+    }
+    Node rebuild(const INode& node, const Nodes& children) {
+      // Create a copy of the node with different children
+      Nodes attributes;
+      auto n = node.getAttributes();
+      for (size_t i = 0; i < n; ++i) {
+        attributes.emplace_back(&node.getAttribute(i));
+      }
+      auto* pattributes = attributes.empty() ? nullptr : &attributes;
+      auto* location = node.getLocation();
+      switch (node.getOperand()) {
+      case INode::Operand::Int:
+        return this->create(location, node.getOpcode(), &children, pattributes, node.getInt());
+      case INode::Operand::Float:
+        return this->create(location, node.getOpcode(), &children, pattributes, node.getFloat());
+      case INode::Operand::String:
+        return this->create(location, node.getOpcode(), &children, pattributes, node.getString());
+      case INode::Operand::Operator:
+        return this->create(location, node.getOpcode(), &children, pattributes, node.getOperator());
+      case INode::Operand::None:
+        break;
+      }
+      return this->create(location, node.getOpcode(), &children, pattributes);
+    }
+    template<typename... ARGS>
+    Node create(const NodeLocation* location, ARGS&&... args) {
+      if (location != nullptr) {
+        return NodeFactory::create(this->allocator, *location, std::forward<ARGS>(args)...);
+      }
+      return NodeFactory::create(this->allocator, std::forward<ARGS>(args)...);
+    }
+    static Operator oper(const INode& node) {
+      // Binary modules store operators as integer operands
+      if (node.getOperand() == INode::Operand::Int) {
+        return Operator(node.getInt());
+      }
+      return node.getOperator();
+    }
+    static bool literal(const INode& node, Variant& value) {
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (node.getOpcode()) {
+      case OPCODE_IVALUE:
+        value = node.getInt();
+        return true;
+      case OPCODE_FVALUE:
+        value = node.getFloat();
+        return true;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      return false;
+    }
+  };
+}
+
+egg::ovum::Node egg::ovum::Optimizer::optimize(IAllocator& allocator, const Node& root) {
+  OptimizerDefault optimizer(allocator);
+  return optimizer.optimize(root);
+}
@@ -0,0 +1,7 @@
+namespace egg::ovum {
+  class Optimizer {
+  public:
+    // Folds constants, prunes unreachable branches and removes no-ops without changing observable behaviour
+    static Node optimize(IAllocator& allocator, const Node& root);
+  };
+}
@@ -47,12 +47,14 @@
 
 // These are system headers (included with a possibly lower warning level)
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <atomic>
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <list>
 #include <map>
 #include <set>
@@ -0,0 +1,740 @@
+#include "ovum/ovum.h"
+#include "ovum/node.h"
+#include "ovum/packed.h"
+#include "ovum/operators.h"
+
+namespace {
+  using namespace egg::ovum;
+
+  const StringLiteral literalEmptyArray{ "[]" };
+  const StringLiteral literalLength{ "length" };
+
+  class ParametersPositional : public IParameters {
+    ParametersPositional(const ParametersPositional&) = delete;
+    ParametersPositional& operator=(const ParametersPositional&) = delete;
+  private:
+    const Variant* positional;
+    size_t count;
+  public:
+    ParametersPositional(const Variant* positional, size_t count)
+      : positional(positional),
+        count(count) {
+    }
+    virtual size_t getPositionalCount() const override {
+      return this->count;
+    }
+    virtual Variant getPositional(size_t index) const override {
+      assert(index < this->count);
+      return this->positional[index];
+    }
+    virtual bool getPositionalLocation(size_t, LocationSource&) const override {
+      return false;
+    }
+    virtual size_t getNamedCount() const override {
+      return 0;
+    }
+    virtual String getName(size_t) const override {
+      return String();
+    }
+    virtual Variant getNamed(const String&) const override {
+      return Variant::Void;
+    }
+    virtual bool getNamedLocation(const String&, LocationSource&) const override {
+      return false;
+    }
+  };
+
+  // How elements of mixed arrays can be ordered without a comparator
+  enum class Ordering { Numeric, Lexical, None };
+
+  template<typename... ARGS>
+  Variant raiseMethod(IExecution& execution, const char* name, ARGS&&... args) {
+    return execution.raiseFormat("Function 'array.", name, "' ", std::forward<ARGS>(args)...);
+  }
+
+  Variant expectNoParameters(IExecution& execution, const char* name, const IParameters& parameters) {
+    if (parameters.getNamedCount() > 0) {
+      return raiseMethod(execution, name, "does not accept named parameters");
+    }
+    if (parameters.getPositionalCount() > 0) {
+      return raiseMethod(execution, name, "does not expect any parameters, but got ", parameters.getPositionalCount());
+    }
+    return Variant::Void;
+  }
+
+  Variant expectCallback(IExecution& execution, const char* name, const IParameters& parameters) {
+    // Returns the callback itself if it looks callable
+    if (parameters.getNamedCount() > 0) {
+      return raiseMethod(execution, name, "does not accept named parameters");
+    }
+    if (parameters.getPositionalCount() != 1) {
+      return raiseMethod(execution, name, "expects one parameter, but got ", parameters.getPositionalCount());
+    }
+    auto parameter = parameters.getPositional(0);
+    if (!parameter.hasObject()) {
+      return raiseMethod(execution, name, "expects its parameter to be a function, but got '", parameter.getRuntimeType().toString(), "' instead");
+    }
+    return parameter;
+  }
+
+  Variant invokeCallback(IExecution& execution, IObject& callback, const Variant* arguments, size_t count) {
+    ParametersPositional parameters(arguments, count);
+    return callback.call(execution, parameters);
+  }
+
+  bool floatLess(Float a, Float b) {
+    // NaNs sort after everything else so that this is a strict weak ordering
+    return (a < b) || (!std::isnan(a) && std::isnan(b));
+  }
+
+  Float numericKey(const Variant& value) {
+    return value.isInt() ? Float(value.getInt()) : value.getFloat();
+  }
+
+  bool numericLess(const Variant& a, const Variant& b) {
+    return floatLess(numericKey(a), numericKey(b));
+  }
+
+  bool lexicalLess(const Variant& a, const Variant& b) {
+    return a.getString().compareTo(b.getString()) < 0;
+  }
+
+  Ordering orderingOf(const std::vector<Variant>& values) {
+    if (std::all_of(values.begin(), values.end(), [](const Variant& value) { return value.isInt() || value.isFloat(); })) {
+      return Ordering::Numeric;
+    }
+    if (std::all_of(values.begin(), values.end(), [](const Variant& value) { return value.isString(); })) {
+      return Ordering::Lexical;
+    }
+    return Ordering::None;
+  }
+
+  PackedArray::Packing packingOf(const Variant& value) {
+    if (value.isInt()) {
+      return PackedArray::Packing::Int;
+    }
+    if (value.isFloat()) {
+      return PackedArray::Packing::Float;
+    }
+    if (value.isString()) {
+      return PackedArray::Packing::String;
+    }
+    return PackedArray::Packing::Mixed;
+  }
+
+  PackedArray::Packing packingOf(const std::vector<Variant>& elements) {
+    // Empty arrays start off packed as integers
+    if (elements.empty()) {
+      return PackedArray::Packing::Int;
+    }
+    auto packing = packingOf(elements.front());
+    if (std::all_of(elements.begin(), elements.end(), [packing](const Variant& element) { return packingOf(element) == packing; })) {
+      return packing;
+    }
+    return PackedArray::Packing::Mixed;
+  }
+
+  template<typename T>
+  void store(std::vector<T>& vector, size_t index, const T& value) {
+    if (index < vector.size()) {
+      vector[index] = value;
+    } else {
+      assert(index == vector.size());
+      vector.push_back(value);
+    }
+  }
+
+  template<typename LESS>
+  Variant mergeSort(std::vector<Variant>& values, LESS less) {
+    // Bottom-up stable merge sort that only ever compares elements at in-range indices
+    // Unlike 'std::stable_sort' it remains well-defined if 'less' is not a strict weak ordering
+    auto n = values.size();
+    std::vector<Variant> buffer(n);
+    for (size_t width = 1; width < n; width *= 2) {
+      for (size_t lo = 0; lo < n; lo += 2 * width) {
+        auto mid = std::min(lo + width, n);
+        auto hi = std::min(lo + 2 * width, n);
+        auto i = lo;
+        auto j = mid;
+        auto k = lo;
+        while ((i < mid) && (j < hi)) {
+          // Only take from the right-hand run if it is strictly less (for stability)
+          bool right = false;
+          auto failure = less(values[j], values[i], right);
+          if (!failure.isVoid()) {
+            return failure;
+          }
+          buffer[k++] = right ? values[j++] : values[i++];
+        }
+        while (i < mid) {
+          buffer[k++] = values[i++];
+        }
+        while (j < hi) {
+          buffer[k++] = values[j++];
+        }
+      }
+      values.swap(buffer);
+    }
+    return Variant::Void;
+  }
+
+  template<typename T>
+  void copy(std::vector<T>& dst, const std::vector<T>& src, size_t begin, size_t end) {
+    dst.assign(src.begin() + std::ptrdiff_t(begin), src.begin() + std::ptrdiff_t(end));
+  }
+}
+
+egg::ovum::PackedArray::PackedArray()
+  : packing(Packing::Int) {
+}
+
+egg::ovum::PackedArray::PackedArray(std::vector<Variant>&& elements)
+  : packing(packingOf(elements)) {
+  switch (this->packing) {
+  case Packing::Int:
+    this->ints.reserve(elements.size());
+    for (auto& element : elements) {
+      this->ints.push_back(element.getInt());
+    }
+    break;
+  case Packing::Float:
+    this->floats.reserve(elements.size());
+    for (auto& element : elements) {
+      this->floats.push_back(element.getFloat());
+    }
+    break;
+  case Packing::String:
+    this->strings.reserve(elements.size());
+    for (auto& element : elements) {
+      this->strings.push_back(element.getString());
+    }
+    break;
+  case Packing::Mixed:
+    this->values = std::move(elements);
+    break;
+  }
+}
+
+size_t egg::ovum::PackedArray::size() const {
+  switch (this->packing) {
+  case Packing::Int:
+    return this->ints.size();
+  case Packing::Float:
+    return this->floats.size();
+  case Packing::String:
+    return this->strings.size();
+  case Packing::Mixed:
+    break;
+  }
+  return this->values.size();
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::get(size_t index) const {
+  assert(index < this->size());
+  switch (this->packing) {
+  case Packing::Int:
+    return Variant(this->ints[index]);
+  case Packing::Float:
+    return Variant(this->floats[index]);
+  case Packing::String:
+    return Variant(this->strings[index]);
+  case Packing::Mixed:
+    break;
+  }
+  return this->values[index];
+}
+
+egg::ovum::Variant* egg::ovum::PackedArray::set(size_t index, const Variant& value) {
+  auto size = this->size();
+  assert(index <= size);
+  if (size == 0) {
+    // An empty array can adopt whichever packing suits its first element
+    this->clear(packingOf(value));
+  }
+  switch (this->packing) {
+  case Packing::Int:
+    if (value.isInt()) {
+      store(this->ints, index, value.getInt());
+      return nullptr;
+    }
+    break;
+  case Packing::Float:
+    if (value.isFloat()) {
+      store(this->floats, index, value.getFloat());
+      return nullptr;
+    }
+    break;
+  case Packing::String:
+    if (value.isString()) {
+      store(this->strings, index, value.getString());
+      return nullptr;
+    }
+    break;
+  case Packing::Mixed:
+    break;
+  }
+  this->unpack();
+  store(this->values, index, value);
+  return &this->values[index];
+}
+
+void egg::ovum::PackedArray::resize(size_t size) {
+  if (size <= this->size()) {
+    switch (this->packing) {
+    case Packing::Int:
+      this->ints.resize(size);
+      return;
+    case Packing::Float:
+      this->floats.resize(size);
+      return;
+    case Packing::String:
+      this->strings.resize(size);
+      return;
+    case Packing::Mixed:
+      break;
+    }
+  } else {
+    // Growing pads with nulls, which only mixed storage can hold
+    this->unpack();
+  }
+  this->values.resize(size, Variant::Null);
+}
+
+void egg::ovum::PackedArray::softVisitLinks(const ICollectable::Visitor& visitor) const {
+  // Packed elements cannot hold links
+  for (auto& value : this->values) {
+    value.softVisitLink(visitor);
+  }
+}
+
+void egg::ovum::PackedArray::soften(IBasket& basket) {
+  for (auto& value : this->values) {
+    value.soften(basket);
+  }
+}
+
+egg::ovum::String egg::ovum::PackedArray::toString() const {
+  auto n = this->size();
+  if (n == 0) {
+    return literalEmptyArray;
+  }
+  StringBuilder sb;
+  char separator = '[';
+  for (size_t i = 0; i < n; ++i) {
+    sb.add(separator, this->get(i).toString());
+    separator = ',';
+  }
+  sb.add(']');
+  return sb.str();
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::fill(IExecution& execution, const IParameters& parameters, const Factory&) {
+  if ((parameters.getNamedCount() > 0) || (parameters.getPositionalCount() != 1)) {
+    return raiseMethod(execution, "fill", "expects exactly one positional parameter");
+  }
+  // Every element becomes the same, so the packing can be chosen afresh
+  auto value = parameters.getPositional(0);
+  auto n = this->size();
+  this->clear(packingOf(value));
+  switch (this->packing) {
+  case Packing::Int:
+    this->ints.assign(n, value.getInt());
+    break;
+  case Packing::Float:
+    this->floats.assign(n, value.getFloat());
+    break;
+  case Packing::String:
+    this->strings.assign(n, value.getString());
+    break;
+  case Packing::Mixed:
+    this->values.assign(n, value);
+    break;
+  }
+  return Variant::Void;
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::reverse(IExecution& execution, const IParameters& parameters, const Factory&) {
+  auto retval = expectNoParameters(execution, "reverse", parameters);
+  if (retval.hasFlowControl()) {
+    return retval;
+  }
+  switch (this->packing) {
+  case Packing::Int:
+    std::reverse(this->ints.begin(), this->ints.end());
+    break;
+  case Packing::Float:
+    std::reverse(this->floats.begin(), this->floats.end());
+    break;
+  case Packing::String:
+    std::reverse(this->strings.begin(), this->strings.end());
+    break;
+  case Packing::Mixed:
+    std::reverse(this->values.begin(), this->values.end());
+    break;
+  }
+  return Variant::Void;
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::sort(IExecution& execution, const IParameters& parameters, const Factory&) {
+  if ((parameters.getNamedCount() > 0) || (parameters.getPositionalCount() > 1)) {
+    return raiseMethod(execution, "sort", "expects at most one positional parameter");
+  }
+  auto comparator = (parameters.getPositionalCount() > 0) ? parameters.getPositional(0) : Variant::Null;
+  if (comparator.isNull()) {
+    // Natural ordering: packed elements are sorted in place without boxing
+    switch (this->packing) {
+    case Packing::Int:
+      std::sort(this->ints.begin(), this->ints.end());
+      return Variant::Void;
+    case Packing::Float:
+      std::sort(this->floats.begin(), this->floats.end(), floatLess);
+      return Variant::Void;
+    case Packing::String:
+      std::sort(this->strings.begin(), this->strings.end(), [](const String& a, const String& b) { return a.compareTo(b) < 0; });
+      return Variant::Void;
+    case Packing::Mixed:
+      break;
+    }
+    switch (orderingOf(this->values)) {
+    case Ordering::Numeric:
+      std::stable_sort(this->values.begin(), this->values.end(), numericLess);
+      return Variant::Void;
+    case Ordering::Lexical:
+      std::stable_sort(this->values.begin(), this->values.end(), lexicalLess);
+      return Variant::Void;
+    case Ordering::None:
+      break;
+    }
+    return raiseMethod(execution, "sort", "expects a comparator unless all the elements are numbers or all are strings");
+  }
+  if (!comparator.hasObject()) {
+    return raiseMethod(execution, "sort", "expects its parameter to be a comparator function, but got '", comparator.getRuntimeType().toString(), "' instead");
+  }
+  // Sort a copy so that the comparator cannot observe or upset a partially-sorted array
+  auto callback = comparator.getObject();
+  auto n = this->size();
+  std::vector<Variant> sorted;
+  sorted.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    sorted.push_back(this->get(i));
+  }
+  auto failure = mergeSort(sorted, [&](const Variant& a, const Variant& b, bool& less) {
+    Variant arguments[] = { a, b };
+    auto result = invokeCallback(execution, *callback, arguments, 2);
+    if (result.hasFlowControl()) {
+      return result;
+    }
+    if (!result.isInt()) {
+      return raiseMethod(execution, "sort", "expects its comparator to return an 'int', but got '", result.getRuntimeType().toString(), "' instead");
+    }
+    less = result.getInt() < 0;
+    return Variant::Void;
+  });
+  if (!failure.isVoid()) {
+    return failure;
+  }
+  *this = PackedArray(std::move(sorted));
+  return Variant::Void;
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::indexOf(IExecution& execution, const IParameters& parameters, const Factory&) {
+  if ((parameters.getNamedCount() > 0) || (parameters.getPositionalCount() != 1)) {
+    return raiseMethod(execution, "indexOf", "expects exactly one positional parameter");
+  }
+  auto value = parameters.getPositional(0);
+  switch (this->packing) {
+  case Packing::Int:
+    if (value.isInt()) {
+      auto found = std::find(this->ints.begin(), this->ints.end(), value.getInt());
+      return (found == this->ints.end()) ? Variant::Null : Variant(Int(found - this->ints.begin()));
+    }
+    break;
+  case Packing::Float:
+    if (value.isFloat()) {
+      auto found = std::find(this->floats.begin(), this->floats.end(), value.getFloat());
+      return (found == this->floats.end()) ? Variant::Null : Variant(Int(found - this->floats.begin()));
+    }
+    break;
+  case Packing::String:
+    if (value.isString()) {
+      auto needle = value.getString();
+      auto found = std::find_if(this->strings.begin(), this->strings.end(), [&needle](const String& element) { return element.equals(needle); });
+      return (found == this->strings.end()) ? Variant::Null : Variant(Int(found - this->strings.begin()));
+    }
+    break;
+  case Packing::Mixed:
+    break;
+  }
+  // Fall back to the semantics of '==' (e.g. 1 == 1.0)
+  auto n = this->size();
+  for (size_t i = 0; i < n; ++i) {
+    if (Variant::equals(this->get(i), value)) {
+      return Variant(Int(i));
+    }
+  }
+  return Variant::Null;
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::sum(IExecution& execution, const IParameters& parameters, const Factory&) {
+  auto retval = expectNoParameters(execution, "sum", parameters);
+  if (retval.hasFlowControl()) {
+    return retval;
+  }
+  switch (this->packing) {
+  case Packing::Int: {
+    // Overflow raises the same exception as a loop of '+' would
+    Int total = 0;
+    for (auto value : this->ints) {
+      if (!IntArithmetic::add(total, value, total)) {
+        return execution.raiseFormat("Integer overflow in addition");
+      }
+    }
+    return Variant(total);
+  }
+  case Packing::Float: {
+    Float total = 0;
+    for (auto value : this->floats) {
+      total += value;
+    }
+    return Variant(total);
+  }
+  case Packing::String:
+  case Packing::Mixed:
+    break;
+  }
+  // Accumulate exactly as a loop of '+' would, switching to floats on the first float
+  Int itotal = 0;
+  Float ftotal = 0;
+  bool floating = false;
+  auto n = this->size();
+  for (size_t i = 0; i < n; ++i) {
+    auto value = this->get(i);
+    if (value.isInt()) {
+      if (floating) {
+        ftotal += Float(value.getInt());
+      } else if (!IntArithmetic::add(itotal, value.getInt(), itotal)) {
+        return execution.raiseFormat("Integer overflow in addition");
+      }
+    } else if (value.isFloat()) {
+      if (!floating) {
+        ftotal = Float(itotal);
+        floating = true;
+      }
+      ftotal += value.getFloat();
+    } else {
+      return raiseMethod(execution, "sum", "expects all the elements to be numbers, but element ", i, " is '", value.getRuntimeType().toString(), "'");
+    }
+  }
+  return floating ? Variant(ftotal) : Variant(itotal);
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::minimum(IExecution& execution, const IParameters& parameters, const Factory&) {
+  auto retval = expectNoParameters(execution, "min", parameters);
+  if (retval.hasFlowControl()) {
+    return retval;
+  }
+  return this->extremum(execution, "min", false);
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::maximum(IExecution& execution, const IParameters& parameters, const Factory&) {
+  auto retval = expectNoParameters(execution, "max", parameters);
+  if (retval.hasFlowControl()) {
+    return retval;
+  }
+  return this->extremum(execution, "max", true);
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::slice(IExecution& execution, const IParameters& parameters, const Factory& factory) {
+  auto n = parameters.getPositionalCount();
+  if ((parameters.getNamedCount() > 0) || (n < 1) || (n > 2)) {
+    return raiseMethod(execution, "slice", "expects one or two positional parameters");
+  }
+  auto p0 = parameters.getPositional(0);
+  if (!p0.isInt()) {
+    return raiseMethod(execution, "slice", "expects its first parameter to be an 'int', but got '", p0.getRuntimeType().toString(), "' instead");
+  }
+  auto p1 = (n > 1) ? parameters.getPositional(1) : Variant::Null;
+  if (!p1.isNull() && !p1.isInt()) {
+    return raiseMethod(execution, "slice", "expects its optional second parameter to be an 'int', but got '", p1.getRuntimeType().toString(), "' instead");
+  }
+  // Negative indices count back from the end, just like 'string.slice()'
+  auto size = Int(this->size());
+  auto begin = p0.getInt();
+  auto end = p1.isNull() ? size : p1.getInt();
+  auto a = size_t((begin < 0) ? std::max(size + begin, Int(0)) : std::min(begin, size));
+  auto b = size_t((end < 0) ? std::max(size + end, Int(0)) : std::min(end, size));
+  PackedArray result;
+  if (a < b) {
+    result.clear(this->packing);
+    switch (this->packing) {
+    case Packing::Int:
+      copy(result.ints, this->ints, a, b);
+      break;
+    case Packing::Float:
+      copy(result.floats, this->floats, a, b);
+      break;
+    case Packing::String:
+      copy(result.strings, this->strings, a, b);
+      break;
+    case Packing::Mixed:
+      copy(result.values, this->values, a, b);
+      break;
+    }
+  }
+  return factory(std::move(result));
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::concat(IExecution& execution, const IParameters& parameters, const Factory& factory) {
+  if (parameters.getNamedCount() > 0) {
+    return raiseMethod(execution, "concat", "does not accept named parameters");
+  }
+  PackedArray result;
+  auto n = this->size();
+  for (size_t i = 0; i < n; ++i) {
+    (void)result.set(i, this->get(i));
+  }
+  // Other arrays are read through their public interface so that any array-like object can be concatenated
+  auto count = parameters.getPositionalCount();
+  for (size_t p = 0; p < count; ++p) {
+    auto parameter = parameters.getPositional(p);
+    if (!parameter.hasObject()) {
+      return raiseMethod(execution, "concat", "expects its parameters to be arrays, but parameter ", p, " is '", parameter.getRuntimeType().toString(), "'");
+    }
+    auto other = parameter.getObject();
+    auto length = other->getProperty(execution, literalLength);
+    if (length.hasFlowControl()) {
+      return length;
+    }
+    if (!length.isInt() || (length.getInt() < 0)) {
+      return raiseMethod(execution, "concat", "expects its parameters to be arrays, but parameter ", p, " has no valid length");
+    }
+    auto m = size_t(length.getInt());
+    for (size_t i = 0; i < m; ++i) {
+      auto element = other->getIndex(execution, Variant(Int(i)));
+      if (element.hasFlowControl()) {
+        return element;
+      }
+      (void)result.set(result.size(), element);
+    }
+  }
+  return factory(std::move(result));
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::map(IExecution& execution, const IParameters& parameters, const Factory& factory) {
+  auto retval = expectCallback(execution, "map", parameters);
+  if (retval.hasFlowControl()) {
+    return retval;
+  }
+  auto callback = retval.getObject();
+  // The callback may modify this array, so re-check the size every time
+  PackedArray result;
+  for (size_t i = 0; i < this->size(); ++i) {
+    Variant arguments[] = { this->get(i) };
+    auto mapped = invokeCallback(execution, *callback, arguments, 1);
+    if (mapped.hasFlowControl()) {
+      return mapped;
+    }
+    if (mapped.isVoid()) {
+      return raiseMethod(execution, "map", "expects its callback to return a value");
+    }
+    (void)result.set(result.size(), mapped);
+  }
+  return factory(std::move(result));
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::filter(IExecution& execution, const IParameters& parameters, const Factory& factory) {
+  auto retval = expectCallback(execution, "filter", parameters);
+  if (retval.hasFlowControl()) {
+    return retval;
+  }
+  auto callback = retval.getObject();
+  // The callback may modify this array, so re-check the size every time
+  PackedArray result;
+  for (size_t i = 0; i < this->size(); ++i) {
+    Variant arguments[] = { this->get(i) };
+    auto keep = invokeCallback(execution, *callback, arguments, 1);
+    if (keep.hasFlowControl()) {
+      return keep;
+    }
+    if (!keep.isBool()) {
+      return raiseMethod(execution, "filter", "expects its callback to return a 'bool', but got '", keep.getRuntimeType().toString(), "' instead");
+    }
+    if (keep.getBool()) {
+      (void)result.set(result.size(), arguments[0]);
+    }
+  }
+  return factory(std::move(result));
+}
+
+egg::ovum::PackedArray::Method egg::ovum::PackedArray::findMethod(const String& name) {
+  static const std::map<String, Method> table = {
+    { "concat",  &PackedArray::concat },
+    { "fill",    &PackedArray::fill },
+    { "filter",  &PackedArray::filter },
+    { "indexOf", &PackedArray::indexOf },
+    { "map",     &PackedArray::map },
+    { "max",     &PackedArray::maximum },
+    { "min",     &PackedArray::minimum },
+    { "reverse", &PackedArray::reverse },
+    { "slice",   &PackedArray::slice },
+    { "sort",    &PackedArray::sort },
+    { "sum",     &PackedArray::sum }
+  };
+  auto found = table.find(name);
+  return (found == table.end()) ? nullptr : found->second;
+}
+
+bool egg::ovum::PackedArray::storesValues(Method method) {
+  // Other mutating methods only rearrange the existing elements
+  return method == &PackedArray::fill;
+}
+
+void egg::ovum::PackedArray::unpack() {
+  // Transition to generic storage on the first mismatched store (there's no way back)
+  if (this->packing != Packing::Mixed) {
+    auto n = this->size();
+    std::vector<Variant> unpacked;
+    unpacked.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      unpacked.push_back(this->get(i));
+    }
+    this->clear(Packing::Mixed);
+    this->values = std::move(unpacked);
+  }
+}
+
+void egg::ovum::PackedArray::clear(Packing replacement) {
+  // Release all the storage and start afresh
+  std::vector<Int>().swap(this->ints);
+  std::vector<Float>().swap(this->floats);
+  std::vector<String>().swap(this->strings);
+  std::vector<Variant>().swap(this->values);
+  this->packing = replacement;
+}
+
+egg::ovum::Variant egg::ovum::PackedArray::extremum(IExecution& execution, const char* name, bool largest) const {
+  if (this->size() == 0) {
+    return Variant::Null;
+  }
+  switch (this->packing) {
+  case Packing::Int:
+    return Variant(largest ? *std::max_element(this->ints.begin(), this->ints.end()) : *std::min_element(this->ints.begin(), this->ints.end()));
+  case Packing::Float:
+    return Variant(largest ? *std::max_element(this->floats.begin(), this->floats.end(), floatLess) : *std::min_element(this->floats.begin(), this->floats.end(), floatLess));
+  case Packing::String: {
+    auto less = [](const String& a, const String& b) { return a.compareTo(b) < 0; };
+    return Variant(largest ? *std::max_element(this->strings.begin(), this->strings.end(), less) : *std::min_element(this->strings.begin(), this->strings.end(), less));
+  }
+  case Packing::Mixed:
+    break;
+  }
+  switch (orderingOf(this->values)) {
+  case Ordering::Numeric:
+    return largest ? *std::max_element(this->values.begin(), this->values.end(), numericLess) : *std::min_element(this->values.begin(), this->values.end(), numericLess);
+  case Ordering::Lexical:
+    return largest ? *std::max_element(this->values.begin(), this->values.end(), lexicalLess) : *std::min_element(this->values.begin(), this->values.end(), lexicalLess);
+  case Ordering::None:
+    break;
+  }
+  return raiseMethod(execution, name, "expects all the elements to be numbers or all to be strings");
+}
@@ -0,0 +1,48 @@
+namespace egg::ovum {
+  class PackedArray {
+    PackedArray(const PackedArray&) = delete;
+    PackedArray& operator=(const PackedArray&) = delete;
+  public:
+    // Arrays that have only ever held ints, floats or strings keep them unboxed
+    enum class Packing { Int, Float, String, Mixed };
+    using Factory = std::function<Variant(PackedArray&& elements)>;
+    using Method = Variant(PackedArray::*)(IExecution& execution, const IParameters& parameters, const Factory& factory);
+  private:
+    Packing packing;
+    std::vector<Int> ints;
+    std::vector<Float> floats;
+    std::vector<String> strings;
+    std::vector<Variant> values;
+  public:
+    PackedArray();
+    explicit PackedArray(std::vector<Variant>&& elements);
+    PackedArray(PackedArray&&) = default;
+    PackedArray& operator=(PackedArray&&) = default;
+    // Elements
+    size_t size() const;
+    Variant get(size_t index) const;
+    Variant* set(size_t index, const Variant& value); // May append; returns the slot if the value was not packed
+    void resize(size_t size);
+    void softVisitLinks(const ICollectable::Visitor& visitor) const;
+    void soften(IBasket& basket);
+    String toString() const;
+    // Native methods
+    Variant fill(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant reverse(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant sort(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant indexOf(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant sum(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant minimum(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant maximum(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant slice(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant concat(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant map(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    Variant filter(IExecution& execution, const IParameters& parameters, const Factory& factory);
+    static Method findMethod(const String& name); // Returns null if not a native method
+    static bool storesValues(Method method); // Returns true if the method may store values that have not been softened
+  private:
+    void unpack();
+    void clear(Packing replacement);
+    Variant extremum(IExecution& execution, const char* name, bool largest) const;
+  };
+}
@@ -4,14 +4,26 @@
 #include "ovum/program.h"
 #include "ovum/function.h"
 #include "ovum/utf.h"
+#include "ovum/operators.h"
 
 #include <cmath>
+#include <deque>
+#include <unordered_map>
 
 namespace {
   using namespace egg::ovum;
 
+  const StringLiteral literalLeft{ "left" };
+  const StringLiteral literalOperator{ "operator" };
+  const StringLiteral literalRight{ "right" };
+  const StringLiteral literalAssert{ "assert" };
+  const StringLiteral literalPrint{ "print" };
+  const StringLiteral literalString{ "string" };
+  const StringLiteral literalType{ "type" };
+
   // Forward declarations
   class Block;
+  class Generator;
   class ProgramDefault;
 
   class RuntimeException : public std::runtime_error {
@@ -27,233 +39,6 @@ namespace {
     }
   };
 
-  class Binary {
-  public:
-    enum class Match { Bool, Int, Float, Mismatch };
-    static Variant apply(Operator oper, Variant& lvalue, const Variant& rvalue) {
-      // Returns 'Break' if operator not known
-      auto retval = Variant::Break;
-      Float lfloat, rfloat;
-      uint64_t uvalue;
-      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
-      switch (oper) {
-      case OPERATOR_ADD:
-        switch (Binary::arithmetic("addition", lvalue, rvalue, lfloat, rfloat, retval)) {
-        case Match::Float:
-          lvalue = lfloat + rfloat;
-          return Variant::Void;
-        case Match::Int:
-          lvalue = lvalue.getInt() + rvalue.getInt();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_SUB:
-        switch (Binary::arithmetic("subtraction", lvalue, rvalue, lfloat, rfloat, retval)) {
-        case Match::Float:
-          lvalue = lfloat - rfloat;
-          return Variant::Void;
-        case Match::Int:
-          lvalue = lvalue.getInt() - rvalue.getInt();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_MUL:
-        switch (Binary::arithmetic("multiplication", lvalue, rvalue, lfloat, rfloat, retval)) {
-        case Match::Float:
-          lvalue = lfloat * rfloat;
-          return Variant::Void;
-        case Match::Int:
-          lvalue = lvalue.getInt() * rvalue.getInt();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_DIV:
-        switch (Binary::arithmetic("division", lvalue, rvalue, lfloat, rfloat, retval)) {
-        case Match::Float:
-          lvalue = lfloat / rfloat;
-          return Variant::Void;
-        case Match::Int:
-          lvalue = lvalue.getInt() / rvalue.getInt();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_REM:
-        switch (Binary::arithmetic("remainder", lvalue, rvalue, lfloat, rfloat, retval)) {
-        case Match::Float:
-          lvalue = std::remainder(lfloat, rfloat);
-          return Variant::Void;
-        case Match::Int:
-          lvalue = lvalue.getInt() % rvalue.getInt();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_BITAND:
-        switch (Binary::bitwise("bitwise-and", lvalue, rvalue, retval)) {
-        case Match::Int:
-          lvalue = lvalue.getInt() & rvalue.getInt();
-          return Variant::Void;
-        case Match::Bool:
-          lvalue = lvalue.getBool() && rvalue.getBool();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_BITOR:
-        switch (Binary::bitwise("bitwise-or", lvalue, rvalue, retval)) {
-        case Match::Int:
-          lvalue = lvalue.getInt() | rvalue.getInt();
-          return Variant::Void;
-        case Match::Bool:
-          lvalue = lvalue.getBool() || rvalue.getBool();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_BITXOR:
-        switch (Binary::bitwise("bitwise-xor", lvalue, rvalue, retval)) {
-        case Match::Int:
-          lvalue = lvalue.getInt() ^ rvalue.getInt();
-          return Variant::Void;
-        case Match::Bool:
-          lvalue = bool(lvalue.getBool() ^ rvalue.getBool());
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_LOGAND:
-        // Note that short-circuiting is handled previously in Target::apply()
-        switch (Binary::logical("logical-and", lvalue, rvalue, retval)) {
-        case Match::Bool:
-          lvalue = lvalue.getBool() && rvalue.getBool();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_LOGOR:
-        // Note that short-circuiting is handled previously in Target::apply()
-        switch (Binary::logical("logical-or", lvalue, rvalue, retval)) {
-        case Match::Bool:
-          lvalue = lvalue.getBool() || rvalue.getBool();
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_SHIFTL:
-        switch (Binary::shift("left-shift", lvalue, rvalue, uvalue, retval)) {
-        case Match::Int:
-          lvalue = lvalue.getInt() << uvalue;
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_SHIFTR:
-        switch (Binary::shift("right-shift", lvalue, rvalue, uvalue, retval)) {
-        case Match::Int:
-          lvalue = lvalue.getInt() >> uvalue;
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_SHIFTU:
-        switch (Binary::shift("unsigned-right-shift", lvalue, rvalue, uvalue, retval)) {
-        case Match::Int:
-          lvalue = Int(uint64_t(lvalue.getInt()) >> uvalue);
-          return Variant::Void;
-        }
-        break;
-      case OPERATOR_IFNULL:
-        if (lvalue.isNull()) {
-          lvalue = rvalue;
-        }
-        return Variant::Void;
-      }
-      EGG_WARNING_SUPPRESS_SWITCH_END();
-      return retval;
-    }
-    static Match arithmetic(const char* operation, const Variant& a, const Variant& b, Float& fa, Float& fb, Variant& retval) {
-      // Promote integers to floats where appropriate
-      if (a.isFloat()) {
-        if (b.isFloat()) {
-          fa = a.getFloat();
-          fb = b.getFloat();
-          return Match::Float;
-        } else if (b.isInt()) {
-          // TODO overflow
-          fa = a.getFloat();
-          fb = Float(b.getInt());
-          return Match::Float;
-        }
-        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int' or 'float'");
-        return Match::Mismatch;
-      }
-      if (a.isInt()) {
-        if (b.isFloat()) {
-          // TODO overflow
-          fa = Float(a.getInt());
-          fb = b.getFloat();
-          return Match::Float;
-        } else if (b.isInt()) {
-          return Match::Int;
-        }
-        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int' or 'float'");
-        return Match::Mismatch;
-      }
-      retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be an 'int' or 'float'");
-      return Match::Mismatch;
-    }
-    static Match bitwise(const char* operation, const Variant& a, const Variant& b, Variant& retval) {
-      // Accept matching ints or bools
-      if (a.isInt()) {
-        if (b.isInt()) {
-          return Match::Int;
-        }
-        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int'");
-        return Match::Mismatch;
-      }
-      if (a.isBool()) {
-        if (b.isBool()) {
-          return Match::Bool;
-        }
-        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be a 'bool'");
-        return Match::Mismatch;
-      }
-      retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be a 'bool' or 'int'");
-      return Match::Mismatch;
-    }
-    static Match logical(const char* operation, const Variant& a, const Variant& b, Variant& retval) {
-      // Accept only bools
-      if (!a.isBool()) {
-        retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be a 'bool'");
-        return Match::Mismatch;
-      }
-      if (!b.isBool()) {
-        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be a 'bool'");
-        return Match::Mismatch;
-      }
-      return Match::Bool;
-    }
-    static Match shift(const char* operation, const Variant& a, const Variant& b, uint64_t& ub, Variant& retval) {
-      // Accept only bools
-      if (!a.isInt()) {
-        retval = Binary::unexpected(a, "Expected left-hand side of ", operation, " to be an 'int'");
-        return Match::Mismatch;
-      }
-      if (!b.isInt()) {
-        retval = Binary::unexpected(b, "Expected right-hand side of ", operation, " to be an 'int'");
-        return Match::Mismatch;
-      }
-      auto ib = b.getInt();
-      if (ib < 0) {
-        retval = Binary::raise("Expected right-hand side of ", operation, " to be a non-negative 'int', but got ", std::to_string(ib), " instead");
-        return Match::Mismatch;
-      }
-      ub = uint64_t(ib);
-      return Match::Int;
-    }
-    template<typename... ARGS>
-    static Variant unexpected(const Variant& value, ARGS&&... args) {
-      return Binary::raise(std::forward<ARGS>(args)..., ", but got '", value.getRuntimeType().toString(), "' instead");
-    }
-    template<typename... ARGS>
-    static Variant raise(ARGS&&... args) {
-      Variant exception{ StringBuilder::concat(std::forward<ARGS>(args)...) };
-      return VariantFactory::createException(std::move(exception));
-    }
-  };
-
   struct Symbol {
     Type type;
     String name;
@@ -274,6 +59,16 @@ namespace {
       }
       return retval;
     }
+    void assignProven(IExecution& execution, const Variant& rvalue) {
+      // The compiler proved that the type accepts the value as-is (see ProgramFactory::Proofs to distrust it)
+      this->assignUnchecked(execution, rvalue);
+    }
+    void assignUnchecked(IExecution& execution, const Variant& rvalue) {
+      // The caller guarantees that the symbol's type accepts the value as-is
+      this->value = rvalue;
+      this->value.soften(execution.getBasket());
+      assert(this->value.validate(true));
+    }
     void softVisitLink(const ICollectable::Visitor& visitor) const {
       this->value.softVisitLink(visitor);
     }
@@ -344,23 +139,62 @@ namespace {
   class Parameters : public IParameters {
     Parameters(const Parameters&) = delete;
     Parameters& operator=(const Parameters&) = delete;
+  public:
+    static constexpr size_t Inline = 6;
   private:
-    std::vector<Variant> positional;
-    std::vector<LocationSource> location;
+    struct Positional {
+      Variant value;
+      const INode* node;
+    };
+    const String& file; // Outlives the parameters
+    const INode* caller; // May be null
+    size_t count;
+    Positional fixed[Inline]; // Avoids heap allocation for the common case
+    std::vector<Positional> overflow;
   public:
-    Parameters() = default;
-    void addPositional(const LocationSource& source, Variant&& value) {
-      this->positional.emplace_back(std::move(value));
-      this->location.emplace_back(source);
+    Parameters(const String& file, const INode* caller)
+      : file(file), caller(caller), count(0) {
+    }
+    void clear(const INode* from) {
+      // Release the values but keep any overflow capacity for reuse
+      this->caller = from;
+      auto n = std::min(this->count, Inline);
+      for (size_t i = 0; i < n; ++i) {
+        this->fixed[i].value = Variant::Void;
+      }
+      this->overflow.clear();
+      this->count = 0;
+    }
+    void addPositional(const INode& node, Variant&& value) {
+      if (this->count < Inline) {
+        auto& positional = this->fixed[this->count];
+        positional.value = std::move(value);
+        positional.node = &node;
+      } else {
+        this->overflow.push_back({ std::move(value), &node });
+      }
+      this->count++;
     }
     virtual size_t getPositionalCount() const override {
-      return this->positional.size();
+      return this->count;
     }
     virtual Variant getPositional(size_t index) const override {
-      return this->positional[index];
+      return this->positional(index).value;
     }
-    virtual const LocationSource* getPositionalLocation(size_t index) const override {
-      return &this->location[index];
+    virtual bool getPositionalLocation(size_t index, LocationSource& location) const override {
+      // Only construct the location when it's actually asked for (usually for error messages)
+      auto* source = this->positional(index).node->getLocation();
+      if ((source == nullptr) && (this->caller != nullptr)) {
+        source = this->caller->getLocation();
+      }
+      location.file = this->file;
+      location.line = 0;
+      location.column = 0;
+      if (source != nullptr) {
+        location.line = source->line;
+        location.column = source->column;
+      }
+      return true;
     }
     virtual size_t getNamedCount() const override {
       return 0;
@@ -371,9 +205,14 @@ namespace {
     virtual Variant getNamed(const String&) const override {
       return Variant::Void;
     }
-    virtual const LocationSource* getNamedLocation(const String&) const override {
+    virtual bool getNamedLocation(const String&, LocationSource&) const override {
       // TODO remove
-      return nullptr;
+      return false;
+    }
+  private:
+    const Positional& positional(size_t index) const {
+      assert(index < this->count);
+      return (index < Inline) ? this->fixed[index] : this->overflow[index - Inline];
     }
   };
 
@@ -418,6 +257,41 @@ namespace {
     }
   };
 
+  struct CallPlan {
+    struct Parameter {
+      String name;
+      Type type;
+      size_t position;
+      bool checked; // False for 'any?' which accepts every value except void and pointers
+    };
+    size_t minPositional;
+    size_t maxPositional;
+    bool variadic;
+    bool generator; // Calls bind the parameters and return a suspended generator
+    std::vector<Parameter> parameters;
+    CallPlan(const IFunctionSignature& signature, bool generator)
+      : minPositional(signature.getParameterCount()),
+        maxPositional(signature.getParameterCount()),
+        variadic(false),
+        generator(generator) {
+      // Computed once per function instead of on every call
+      while ((this->minPositional > 0) && !Bits::hasAnySet(signature.getParameter(this->minPositional - 1).getFlags(), IFunctionSignatureParameter::Flags::Required)) {
+        this->minPositional--;
+      }
+      if (this->maxPositional > 0) {
+        this->variadic = Bits::hasAnySet(signature.getParameter(this->maxPositional - 1).getFlags(), IFunctionSignatureParameter::Flags::Variadic);
+      }
+      this->parameters.reserve(this->maxPositional);
+      for (size_t i = 0; i < this->maxPositional; ++i) {
+        auto& parameter = signature.getParameter(i);
+        auto type = parameter.getType();
+        auto checked = type->getBasalTypesLegacy() != BasalBits::AnyQ;
+        this->parameters.push_back({ parameter.getName(), type, parameter.getPosition(), checked });
+        assert(!this->parameters.back().name.empty());
+      }
+    }
+  };
+
   class UserFunction : public SoftReferenceCounted<IObject> {
     UserFunction(const UserFunction&) = delete;
     UserFunction& operator=(const UserFunction&) = delete;
@@ -425,14 +299,16 @@ namespace {
     ProgramDefault& program; // ProgramDefault lifetime guaranteed to be longer than UserFunction instance
     LocationSource location;
     Type type;
+    CallPlan plan;
     Node block;
     SoftPtr<SymbolTable> captured;
   public:
-    UserFunction(IAllocator& allocator, ProgramDefault& program, const LocationSource& location, const Type& type, const INode& block)
+    UserFunction(IAllocator& allocator, ProgramDefault& program, const LocationSource& location, const Type& type, const INode& block, bool generator)
       : SoftReferenceCounted(allocator),
         program(program),
         location(location),
         type(type),
+        plan(*type->callable(), generator),
         block(&block) {
       assert(type != nullptr);
       assert(block.getOpcode() == OPCODE_BLOCK);
@@ -467,6 +343,7 @@ namespace {
     virtual Variant iterate(IExecution& execution) override {
       return this->raise(execution, "does not support iteration");
     }
+    Variant execute(const IParameters& parameters);
     template<typename... ARGS>
     Variant raise(IExecution& execution, ARGS&&... args) {
       auto* signature = this->type->callable();
@@ -496,6 +373,7 @@ namespace {
     Target(ProgramDefault& program, const INode& node, Block* block = nullptr);
     Variant check() const;
     Variant assign(const Variant& rhs) const;
+    Variant assignProven(const Variant& rhs) const;
     Variant nudge(Int rhs) const;
     Variant mutate(const INode& opnode, const INode& rhs) const;
   private:
@@ -518,7 +396,12 @@ namespace {
     bool empty() const {
       return this->declared.empty();
     }
-    Variant declare(const LocationSource& source, const Type& type, const String& name, const Variant* init = nullptr);
+    void reset();
+    void abandon() {
+      // Forget the declarations without touching the symbol table
+      this->declared.clear();
+    }
+    Variant declare(const LocationSource& source, const Type& type, const String& name, const Variant* init = nullptr, bool proven = false);
     Variant guard(const LocationSource& source, const Type& type, const String& name, const Variant& init);
   };
 
@@ -540,6 +423,156 @@ namespace {
     }
   };
 
+  class CallResume final {
+    CallResume(const CallResume&) = delete;
+    CallResume& operator=(const CallResume&) = delete;
+  private:
+    HardPtr<SymbolTable>& symtable;
+    HardPtr<SymbolTable> saved;
+  public:
+    CallResume(HardPtr<SymbolTable>& symtable, SymbolTable& resumed) : symtable(symtable), saved(symtable) {
+      // Temporarily switch to the symbol table of a suspended call
+      this->symtable.set(&resumed);
+    }
+    ~CallResume() {
+      this->symtable = this->saved;
+    }
+  };
+
+  class CallRunning final {
+    CallRunning(const CallRunning&) = delete;
+    CallRunning& operator=(const CallRunning&) = delete;
+  private:
+    bool& running;
+  public:
+    explicit CallRunning(bool& running) : running(running) {
+      // Flag a suspended call as running until we leave this scope, however that happens
+      assert(!this->running);
+      this->running = true;
+    }
+    ~CallRunning() {
+      this->running = false;
+    }
+  };
+
+  class Generator : public SoftReferenceCounted<IObject> {
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    friend class ProgramDefault;
+  private:
+    struct Frame {
+      const INode& node; // Block, 'if', 'while', 'do' or 'for' statement
+      const INode* body; // Block currently being stepped through, if any
+      size_t index; // Next statement within 'body'
+      bool started;
+      Block block;
+      Frame(ProgramDefault& program, const INode& node)
+        : node(node), body(nullptr), index(0), started(false), block(program) {
+      }
+    };
+    ProgramDefault& program; // ProgramDefault lifetime guaranteed to be longer than Generator instance
+    Type type;
+    Node root;
+    SoftPtr<SymbolTable> symtable;
+    std::deque<Frame> stack; // Replaces the native stack between resumptions; storage is recycled in chunks
+    bool running;
+    bool completed;
+  public:
+    Generator(IAllocator& allocator, ProgramDefault& program, const Type& type, const INode& root, SymbolTable& symtable)
+      : SoftReferenceCounted(allocator),
+        program(program),
+        type(type),
+        root(&root),
+        running(false),
+        completed(false) {
+      assert(type != nullptr);
+      assert(root.getOpcode() == OPCODE_BLOCK);
+      this->symtable.set(*this, &symtable);
+    }
+    virtual ~Generator() override {
+      // The symbol table dies with us, so there's no need to undeclare anything
+      for (auto& frame : this->stack) {
+        frame.block.abandon();
+      }
+    }
+    virtual void softVisitLinks(const Visitor& visitor) const override {
+      this->symtable.visit(visitor);
+    }
+    virtual Variant toString() const override {
+      return "<generator>";
+    }
+    virtual Type getRuntimeType() const override {
+      return this->type;
+    }
+    virtual Variant call(IExecution& execution, const IParameters& parameters) override;
+    virtual Variant getProperty(IExecution& execution, const String& property) override {
+      return execution.raiseFormat("Generators do not support properties such as '", property, "'");
+    }
+    virtual Variant setProperty(IExecution& execution, const String& property, const Variant&) override {
+      return execution.raiseFormat("Generators do not support properties such as '", property, "'");
+    }
+    virtual Variant getIndex(IExecution& execution, const Variant&) override {
+      return execution.raise("Generators do not support indexing");
+    }
+    virtual Variant setIndex(IExecution& execution, const Variant&, const Variant&) override {
+      return execution.raise("Generators do not support indexing");
+    }
+    virtual Variant iterate(IExecution&) override {
+      // Generators are their own iterators
+      return Variant(Object(*this));
+    }
+  };
+
+  class SwitchTable final : public HardReferenceCounted<IHardAcquireRelease> {
+    SwitchTable(const SwitchTable&) = delete;
+    SwitchTable& operator=(const SwitchTable&) = delete;
+  public:
+    bool constant; // All labels are int, string or bool literals
+    size_t defclause;
+    size_t bools[2];
+    std::unordered_map<Int, size_t> ints;
+    std::unordered_map<String, size_t> strings;
+    explicit SwitchTable(IAllocator& allocator)
+      : HardReferenceCounted(allocator, 0),
+        constant(true),
+        defclause(0),
+        bools{ 0, 0 } {
+    }
+    static SwitchTable* create(IAllocator& allocator, const INode& node) {
+      // Map each constant label to the index of the first clause containing it
+      auto* table = allocator.create<SwitchTable>(0, allocator);
+      auto n = node.getChildren();
+      for (size_t i = 1; i < n; ++i) {
+        auto& clause = node.getChild(i);
+        auto m = clause.getChildren();
+        for (size_t j = 1; j < m; ++j) {
+          auto& label = clause.getChild(j);
+          switch (label.getOpcode()) {
+          case OPCODE_IVALUE:
+            table->ints.emplace(label.getInt(), i);
+            break;
+          case OPCODE_SVALUE:
+            table->strings.emplace(label.getString(), i);
+            break;
+          case OPCODE_FALSE:
+          case OPCODE_TRUE:
+            if (table->bools[label.getOpcode() == OPCODE_TRUE] == 0) {
+              table->bools[label.getOpcode() == OPCODE_TRUE] = i;
+            }
+            break;
+          default:
+            table->constant = false;
+            return table;
+          }
+        }
+        if (clause.getOpcode() == OPCODE_DEFAULT) {
+          table->defclause = i;
+        }
+      }
+      return table;
+    }
+  };
+
   class ProgramDefault final : public HardReferenceCounted<IProgram>, public IExecution {
     ProgramDefault(const ProgramDefault&) = delete;
     ProgramDefault& operator=(const ProgramDefault&) = delete;
@@ -547,13 +580,46 @@ namespace {
     ILogger& logger;
     Basket basket;
     HardPtr<SymbolTable> symtable;
-    LocationSource location;
+    String file; // Resource name of the module being run
+    const INode* current; // Most recent node visited; its source location is only resolved when needed
+    struct TailCall {
+      HardPtr<UserFunction> function; // Null unless a 'return' has requested a tail call
+      Parameters parameters;
+      explicit TailCall(const String& file) : parameters(file, nullptr) {
+      }
+    };
+    class Frame final {
+      Frame(const Frame&) = delete;
+      Frame& operator=(const Frame&) = delete;
+    private:
+      ProgramDefault& program;
+      TailCall* outer;
+    public:
+      TailCall tail;
+      explicit Frame(ProgramDefault& program) : program(program), outer(program.tail), tail(program.file) {
+        this->program.depth++;
+        this->program.tail = &this->tail;
+      }
+      ~Frame() {
+        this->program.tail = this->outer;
+        this->program.depth--;
+      }
+    };
+    size_t depth; // Number of user function frames currently executing
+    size_t maxDepth;
+    bool trusted; // False if the compiler's type proofs are ignored
+    TailCall* tail; // Null if calls are not currently in tail position
   public:
-    ProgramDefault(IAllocator& allocator, IBasket& basket, ILogger& logger)
+    ProgramDefault(IAllocator& allocator, IBasket& basket, ILogger& logger, size_t maxDepth, ProgramFactory::Proofs proofs)
       : HardReferenceCounted(allocator, 0),
         logger(logger),
         basket(&basket),
-        symtable(allocator.make<SymbolTable>()) {
+        symtable(allocator.make<SymbolTable>()),
+        current(nullptr),
+        depth(0),
+        maxDepth(maxDepth),
+        trusted(proofs == ProgramFactory::Proofs::Trusted),
+        tail(nullptr) {
       this->basket->take(*this->symtable);
     }
     virtual ~ProgramDefault() {
@@ -575,11 +641,14 @@ namespace {
     }
     virtual Variant run(const IModule& module) override {
       try {
-        this->location.file = module.getResourceName();
-        this->location.line = 0;
-        this->location.column = 0;
-        return this->executeRoot(module.getRootNode());
+        this->file = module.getResourceName();
+        this->current = nullptr;
+        assert((this->depth == 0) && (this->tail == nullptr));
+        auto retval = this->executeRoot(module.getRootNode());
+        this->current = nullptr;
+        return retval;
       } catch (RuntimeException& exception) {
+        this->current = nullptr;
         this->logger.log(ILogger::Source::Runtime, ILogger::Severity::Error, exception.message.toUTF8());
         return Variant::Rethrow;
       }
@@ -592,7 +661,7 @@ namespace {
       return *this->basket;
     }
     virtual Variant raise(const String& message) override {
-      return VariantFactory::createException(this->allocator, this->location, message);
+      return VariantFactory::createException(this->allocator, this->location(), message);
     }
     virtual Variant assertion(const Variant& predicate) override {
       if (predicate.hasObject()) {
@@ -640,7 +709,7 @@ namespace {
       auto vname = this->identifier(node.getChild(1));
       auto vtype = this->type(node.getChild(0), vname);
       this->updateLocation(node);
-      a = block.declare(this->location, vtype, vname);
+      a = block.declare(this->location(), vtype, vname);
       if (a.hasFlowControl()) {
         // Couldn't define the variable; leave the error in 'a'
         return Target::Flavour::Failed;
@@ -713,7 +782,7 @@ namespace {
       auto* symbol = this->symtable->get(name);
       if (symbol == nullptr) {
         this->updateLocation(node);
-        throw RuntimeException(this->location, "Unknown target symbol: '", name, "'");
+        throw RuntimeException(this->location(), "Unknown target symbol: '", name, "'");
       }
       return *symbol;
     }
@@ -743,64 +812,91 @@ namespace {
       if (exception.hasObject()) {
         // Augment the exception with the actual evaluation
         auto object = exception.getObject();
-        (void)object->setProperty(*this, "left", lhs);
-        (void)object->setProperty(*this, "operator", OperatorProperties::str(compare.getOperator()));
-        (void)object->setProperty(*this, "right", rhs);
+        (void)object->setProperty(*this, literalLeft, lhs);
+        (void)object->setProperty(*this, literalOperator, OperatorProperties::str(compare.getOperator()));
+        (void)object->setProperty(*this, literalRight, rhs);
       }
       return exception;
     }
-    Variant executeCall(const LocationSource& source, const IFunctionSignature& signature, const IParameters& runtime, const INode& block, SymbolTable& captured) {
+    Variant callUser(UserFunction& function, const IParameters& parameters) {
+      // Recursion is limited by a budget rather than by the size of the native stack
+      if (this->depth >= this->maxDepth) {
+        return this->raiseFormat("Maximum call depth of ", this->maxDepth, " exceeded");
+      }
+      Frame frame(*this);
+      auto retval = function.execute(parameters);
+      while (frame.tail.function != nullptr) {
+        // A 'return' in tail position asked for its call to replace this frame
+        auto callee = std::move(frame.tail.function);
+        retval = callee->execute(frame.tail.parameters);
+      }
+      return retval;
+    }
+    Variant callGenerator(Generator& generator) {
+      // Resume the generator until it yields a value, returns or throws
+      if (generator.completed) {
+        return Variant::Void;
+      }
+      if (generator.running) {
+        return this->raise("Generators cannot be resumed recursively");
+      }
+      if (this->depth >= this->maxDepth) {
+        return this->raiseFormat("Maximum call depth of ", this->maxDepth, " exceeded");
+      }
+      Frame frame(*this);
+      CallResume resume(this->symtable, *generator.symtable);
+      CallRunning running(generator.running);
+      return this->generatorRun(generator);
+    }
+    Variant executeCall(const LocationSource& source, const IFunctionSignature& signature, const CallPlan& plan, const IParameters& runtime, const INode& block, SymbolTable& captured) {
       // We have to be careful to get the location correct
       assert(block.getOpcode() == OPCODE_BLOCK);
       if (runtime.getNamedCount() > 0) {
         return this->raiseFormat(Function::signatureToString(signature), ": Named parameters are not yet supported"); // TODO
       }
-      auto maxPositional = signature.getParameterCount();
-      auto minPositional = maxPositional;
-      while ((minPositional > 0) && !Bits::hasAnySet(signature.getParameter(minPositional - 1).getFlags(), IFunctionSignatureParameter::Flags::Required)) {
-        minPositional--;
-      }
       auto actual = runtime.getPositionalCount();
-      if (actual < minPositional) {
-        if (minPositional == 1) {
+      if (actual < plan.minPositional) {
+        if (plan.minPositional == 1) {
           return this->raiseFormat(Function::signatureToString(signature), ": At least 1 parameter was expected");
         }
-        return this->raiseFormat(Function::signatureToString(signature), ": At least ", minPositional, " parameters were expected, not ", actual);
+        return this->raiseFormat(Function::signatureToString(signature), ": At least ", plan.minPositional, " parameters were expected, not ", actual);
       }
-      if ((maxPositional > 0) && Bits::hasAnySet(signature.getParameter(maxPositional - 1).getFlags(), IFunctionSignatureParameter::Flags::Variadic)) {
+      if (plan.variadic) {
         // TODO Variadic
-      } else if (actual > maxPositional) {
+      } else if (actual > plan.maxPositional) {
         // Not variadic
-        if (maxPositional == 1) {
+        if (plan.maxPositional == 1) {
           return this->raiseFormat(Function::signatureToString(signature), ": Only 1 parameter was expected, not ", actual);
         }
-        return this->raiseFormat(Function::signatureToString(signature), ": No more than ", maxPositional, " parameters were expected, not ", actual);
+        return this->raiseFormat(Function::signatureToString(signature), ": No more than ", plan.maxPositional, " parameters were expected, not ", actual);
       }
       CallStack stack(this->symtable, &captured);
-      Block scope(*this);
-      for (size_t i = 0; i < maxPositional; ++i) {
-        auto& sigparam = signature.getParameter(i);
-        auto pname = sigparam.getName();
-        assert(!pname.empty());
-        auto position = sigparam.getPosition();
-        assert(position < actual);
-        auto ptype = sigparam.getType();
-        auto pvalue = runtime.getPositional(position);
-        auto retval = scope.guard(source, ptype, pname, pvalue);
-        if (retval.hasFlowControl()) {
-          return retval;
-        }
-        assert(retval.isBool());
-        if (!retval.getBool()) {
+      for (auto& parameter : plan.parameters) {
+        // Parameters are bound directly into the new frame; they die with it
+        assert(parameter.position < actual);
+        auto pvalue = runtime.getPositional(parameter.position);
+        auto symbol = this->symtable->add(parameter.type, parameter.name, source);
+        if (!symbol.first) {
+          return this->raiseLocation(source, "Duplicate name in declaration: '", parameter.name, "'");
+        }
+        if (!parameter.checked && pvalue.hasAny(VariantBits::AnyQ)) {
+          symbol.second->assignUnchecked(*this, pvalue);
+        } else if (!symbol.second->tryAssign(*this, pvalue).isVoid()) {
           // Type mismatch on parameter
-          auto* plocation = runtime.getPositionalLocation(position);
-          if (plocation != nullptr) {
-            // Update our current source location (it will be restored when expressionCall returns)
-            this->location = *plocation;
+          auto message = StringBuilder::concat("Type mismatch for parameter '", parameter.name, "': Expected '", parameter.type.toString(), "', but got '", pvalue.getRuntimeType().toString(), "' instead");
+          LocationSource plocation;
+          if (runtime.getPositionalLocation(parameter.position, plocation)) {
+            return this->raiseLocation(plocation, message);
           }
-          return this->raiseFormat("Type mismatch for parameter '", pname, "': Expected '", ptype.toString(), "', but got '", pvalue.getRuntimeType().toString(), "' instead");
+          return this->raise(message);
         }
       }
+      if (plan.generator) {
+        // The body only runs when the generator itself is called
+        auto generator = this->allocator.make<Generator>(*this, signature.getReturnType(), block, *this->symtable);
+        return Variant(Object(*generator));
+      }
+      Block scope(*this);
       auto retval = this->executeBlock(scope, block);
       if (retval.stripFlowControl(VariantBits::Return) || retval.hasThrow()) {
         // We got a return value or exception
@@ -815,14 +911,195 @@ namespace {
           return retval;
         }
       }
-      throw RuntimeException(this->location, "Expected function to return, but got '", retval.getRuntimeType().toString(), "' instead");
+      throw RuntimeException(this->location(), "Expected function to return, but got '", retval.getRuntimeType().toString(), "' instead");
+    }
+    // Generators
+    Variant generatorRun(Generator& generator) {
+      if (generator.stack.empty()) {
+        // First time through
+        generator.stack.emplace_back(*this, *generator.root);
+      }
+      Variant retval = Variant::Void;
+      while (!generator.stack.empty()) {
+        auto& frame = generator.stack.back();
+        auto* next = this->generatorStep(frame, retval);
+        if (next == nullptr) {
+          // The frame has completed with 'retval'
+          generator.stack.pop_back();
+          continue;
+        }
+        this->updateLocation(*next);
+        EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+        switch (next->getOpcode()) {
+        case OPCODE_BLOCK:
+        case OPCODE_IF:
+        case OPCODE_WHILE:
+        case OPCODE_DO:
+        case OPCODE_FOR:
+          // These may contain 'yield' statements so they get their own frame
+          generator.stack.emplace_back(*this, *next);
+          break;
+        case OPCODE_YIELD:
+          if (next->getChildren() != 1) {
+            retval = this->raise("The 'yield ...' statement is not yet supported");
+            break;
+          }
+          retval = this->expression(next->getChild(0));
+          if (!retval.hasFlowControl()) {
+            // Suspend; the next resumption continues with the following statement
+            return retval;
+          }
+          break;
+        default:
+          retval = this->statement(frame.block, *next);
+          break;
+        }
+        EGG_WARNING_SUPPRESS_SWITCH_END();
+      }
+      // Ran off the end, executed 'return' or raised an exception
+      generator.completed = true;
+      if (retval.hasThrow()) {
+        return retval;
+      }
+      return Variant::Void;
+    }
+    const INode* generatorStep(Generator::Frame& frame, Variant& retval) {
+      // Returns the next statement to execute or null if the frame has completed
+      auto& node = frame.node;
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (node.getOpcode()) {
+      case OPCODE_BLOCK:
+        if (!frame.started) {
+          frame.started = true;
+          frame.body = &node;
+        }
+        return this->generatorNext(frame, retval);
+      case OPCODE_IF:
+        if (!frame.started) {
+          frame.started = true;
+          auto* clause = &node;
+          while (clause->getOpcode() == OPCODE_IF) {
+            auto condition = this->condition(clause->getChild(0), &frame.block);
+            if (!condition.isBool()) {
+              // Problem with the condition
+              retval = condition;
+              return nullptr;
+            }
+            if (condition.getBool()) {
+              // Execute the 'then' clause
+              break;
+            }
+            if (clause->getChildren() == 2) {
+              // No 'else' clause
+              return nullptr;
+            }
+            clause = &clause->getChild(2);
+          }
+          frame.body = (clause->getOpcode() == OPCODE_IF) ? &clause->getChild(1) : clause;
+        }
+        return this->generatorNext(frame, retval);
+      case OPCODE_WHILE:
+        for (;;) {
+          if (frame.body == nullptr) {
+            frame.block.reset();
+            auto condition = this->condition(node.getChild(0), &frame.block);
+            if (!condition.isBool() || !condition.getBool()) {
+              // Problem with the condition or the loop has finished
+              retval = condition.isBool() ? Variant::Void : condition;
+              return nullptr;
+            }
+            frame.body = &node.getChild(1);
+          }
+          auto* next = this->generatorNext(frame, retval);
+          if ((next != nullptr) || !this->generatorLoop(retval)) {
+            return next;
+          }
+        }
+      case OPCODE_DO:
+        for (;;) {
+          if (frame.body == nullptr) {
+            if (frame.started) {
+              auto condition = this->condition(node.getChild(0), nullptr); // don't allow guards
+              if (!condition.isBool() || !condition.getBool()) {
+                // Problem with the condition or the loop has finished
+                retval = condition.isBool() ? Variant::Void : condition;
+                return nullptr;
+              }
+            }
+            frame.started = true;
+            frame.block.reset();
+            frame.body = &node.getChild(1);
+          }
+          auto* next = this->generatorNext(frame, retval);
+          if ((next != nullptr) || !this->generatorLoop(retval)) {
+            return next;
+          }
+        }
+      case OPCODE_FOR:
+        if (!frame.started) {
+          frame.started = true;
+          retval = this->statement(frame.block, node.getChild(0));
+          if (retval.hasFlowControl()) {
+            return nullptr;
+          }
+        }
+        for (;;) {
+          if (frame.body == nullptr) {
+            auto& cond = node.getChild(1);
+            if ((cond.getOpcode() != OPCODE_NOOP) && (cond.getOpcode() != OPCODE_TRUE)) {
+              auto condition = this->condition(cond, &frame.block);
+              if (!condition.isBool() || !condition.getBool()) {
+                // Problem with the condition or the loop has finished
+                retval = condition.isBool() ? Variant::Void : condition;
+                return nullptr;
+              }
+            }
+            frame.body = &node.getChild(3);
+          }
+          auto* next = this->generatorNext(frame, retval);
+          if ((next != nullptr) || !this->generatorLoop(retval)) {
+            return next;
+          }
+          retval = this->statement(frame.block, node.getChild(2));
+          if (retval.hasFlowControl()) {
+            return nullptr;
+          }
+        }
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+      throw this->unexpectedOpcode("generator statement", node);
+    }
+    const INode* generatorNext(Generator::Frame& frame, Variant& retval) {
+      // Returns the next statement of the current body or null if the body has completed
+      assert(frame.body != nullptr);
+      if (!retval.hasFlowControl() && (frame.index < frame.body->getChildren())) {
+        return &frame.body->getChild(frame.index++);
+      }
+      if (!retval.hasFlowControl()) {
+        retval = Variant::Void;
+      }
+      frame.body = nullptr;
+      frame.index = 0;
+      return nullptr;
+    }
+    bool generatorLoop(Variant& retval) {
+      // Returns true if a loop should continue after its body has completed with 'retval'
+      if (retval.is(VariantBits::Break)) {
+        retval = Variant::Void;
+        return false;
+      }
+      if (retval.hasFlowControl() && !retval.is(VariantBits::Continue)) {
+        return false;
+      }
+      retval = Variant::Void;
+      return true;
     }
     // Builtins
     void addBuiltins() {
-      this->builtin("assert", VariantFactory::createBuiltinAssert(this->allocator));
-      this->builtin("print", VariantFactory::createBuiltinPrint(this->allocator));
-      this->builtin("string", VariantFactory::createBuiltinString(this->allocator));
-      this->builtin("type", VariantFactory::createBuiltinType(this->allocator));
+      this->builtin(literalAssert, VariantFactory::createBuiltinAssert(this->allocator));
+      this->builtin(literalPrint, VariantFactory::createBuiltinPrint(this->allocator));
+      this->builtin(literalString, VariantFactory::createBuiltinString(this->allocator));
+      this->builtin(literalType, VariantFactory::createBuiltinType(this->allocator));
     }
   private:
     Variant executeRoot(const INode& node) {
@@ -892,6 +1169,9 @@ namespace {
         return this->statementTry(node);
       case OPCODE_WHILE:
         return this->statementWhile(node);
+      case OPCODE_YIELD:
+        // The compiler rejects 'yield' within 'for-each', 'switch' and 'try' statements; this catches hand-built modules
+        return this->raise("The 'yield' statement is only supported directly within blocks, 'if', 'while', 'do' and 'for' statements of generators");
       }
       EGG_WARNING_SUPPRESS_SWITCH_END();
       throw this->unexpectedOpcode("statement", node);
@@ -904,6 +1184,9 @@ namespace {
       if (rvalue.hasFlowControl()) {
         return rvalue;
       }
+      if (this->proven(node)) {
+        return lvalue.assignProven(rvalue);
+      }
       return lvalue.assign(rvalue);
     }
     Variant statementBlock(const INode& node) {
@@ -928,14 +1211,14 @@ namespace {
       auto vtype = this->type(node.getChild(0), vname);
       if (node.getChildren() == 2) {
         // No initializer
-        return block.declare(this->location, vtype, vname);
+        return block.declare(this->location(), vtype, vname);
       }
       assert(node.getChildren() == 3);
       auto vinit = this->expression(node.getChild(2));
       if (vinit.hasFlowControl()) {
         return vinit;
       }
-      return block.declare(this->location, vtype, vname, &vinit);
+      return block.declare(this->location(), vtype, vname, &vinit, this->proven(node));
     }
     Variant statementDecrement(const INode& node) {
       assert(node.getOpcode() == OPCODE_DECREMENT);
@@ -951,7 +1234,14 @@ namespace {
         Block block(*this);
         retval = this->executeBlock(block, node.getChild(1));
         if (retval.hasFlowControl()) {
-          return retval;
+          if (retval.is(VariantBits::Break)) {
+            // Break from the loop
+            break;
+          }
+          if (!retval.is(VariantBits::Continue)) {
+            // Some other flow control
+            return retval;
+          }
         }
         retval = this->condition(node.getChild(0), nullptr); // don't allow guards
         if (!retval.isBool()) {
@@ -1031,6 +1321,11 @@ namespace {
       }
       auto object = rvalue.getObject();
       assert(object != nullptr);
+      auto* iterable = dynamic_cast<IIndexedIterable*>(object.get());
+      if (iterable != nullptr) {
+        // Built-in containers are stepped through directly without an iterator object
+        return this->indexedForeach(*iterable, inner, lvalue, node.getChild(2));
+      }
       auto iterate = object->iterate(*this);
       if (iterate.hasFlowControl()) {
         return iterate;
@@ -1069,18 +1364,38 @@ namespace {
       assert(node.getChildren() == 3);
       auto fname = this->identifier(node.getChild(2));
       auto ftype = this->type(node.getChild(0), fname);
-      auto& fblock = node.getChild(1);
-      if (fblock.getOpcode() != OPCODE_BLOCK) {
-        return this->raise("Generators are not yet supported"); // WIBBLE
+      auto* fblock = &node.getChild(1);
+      auto generator = fblock->getOpcode() == OPCODE_GENERATOR;
+      if (generator) {
+        // 'generator(type, block[, name])'
+        fblock = &fblock->getChild(1);
+        ftype = this->generatorType(fname, ftype);
       }
       this->updateLocation(node);
-      auto function = this->allocator.make<UserFunction>(*this, this->location, ftype, fblock);
+      auto function = this->allocator.make<UserFunction>(*this, this->location(), ftype, *fblock, generator);
       // We have to be careful to ensure the function is declared before capturing symbols so that recursion works correctly
       Variant fvalue{ Object(*function) };
-      auto retval = block.declare(this->location, ftype, fname, &fvalue);
+      auto retval = block.declare(this->location(), ftype, fname, &fvalue);
       function->setCaptured(this->symtable->cloneIndirect()); // TODO don't capture everything WIBBLE
       return retval;
     }
+    Type generatorType(const String& name, const Type& compiled) {
+      // Compiled modules describe 'int...(int)' as '(void|int)()(int)' so reconstruct the generator type
+      auto* signature = compiled->callable();
+      assert(signature != nullptr);
+      auto* iterator = signature->getReturnType()->callable();
+      if (iterator == nullptr) {
+        return compiled;
+      }
+      auto* underlying = FunctionType::createGeneratorType(this->allocator, name, iterator->getReturnType()->devoidedType());
+      Type function{ underlying }; // takes ownership
+      auto n = signature->getParameterCount();
+      for (size_t i = 0; i < n; ++i) {
+        auto& parameter = signature->getParameter(i);
+        underlying->addParameter(parameter.getName(), parameter.getType(), parameter.getFlags(), parameter.getPosition());
+      }
+      return function;
+    }
     Variant statementIf(const INode& node) {
       assert(node.getOpcode() == OPCODE_IF);
       auto n = &node;
@@ -1127,7 +1442,8 @@ namespace {
         // A naked return
         return Variant::ReturnVoid;
       }
-      auto retval = this->expression(node.getChild(0));
+      auto& expr = node.getChild(0);
+      auto retval = ((this->tail != nullptr) && (expr.getOpcode() == OPCODE_CALL)) ? this->expressionTailCall(expr) : this->expression(expr);
       if (!retval.hasFlowControl()) {
         // Convert the expression to a return
         assert(!retval.isVoid());
@@ -1144,40 +1460,38 @@ namespace {
         // Failed to evaluate the value to match
         return match;
       }
-      size_t defclause = 0;
       size_t matched = 0;
-      for (size_t i = 1; i < n; ++i) {
-        // Look for the first matching case clause
-        auto& clause = node.getChild(i);
-        auto m = clause.getChildren();
-        assert(m >= 1);
-        assert((clause.getOpcode() == OPCODE_CASE) || (clause.getOpcode() == OPCODE_DEFAULT));
-        for (size_t j = 1; !matched && (j < m); ++j) {
-          auto expr = this->expression(node.getChild(0));
-          if (expr.hasFlowControl()) {
-            // Failed to evaluate the value to match
-            return expr;
+      if (!this->switchDispatch(node, match, matched)) {
+        size_t defclause = 0;
+        for (size_t i = 1; (matched == 0) && (i < n); ++i) {
+          // Look for the first matching case clause
+          auto& clause = node.getChild(i);
+          auto m = clause.getChildren();
+          assert(m >= 1);
+          assert((clause.getOpcode() == OPCODE_CASE) || (clause.getOpcode() == OPCODE_DEFAULT));
+          for (size_t j = 1; j < m; ++j) {
+            auto expr = this->expression(clause.getChild(j));
+            if (expr.hasFlowControl()) {
+              // Failed to evaluate the value to match
+              return expr;
+            }
+            if (Variant::equals(expr, match)) {
+              // We've matched this clause
+              matched = i;
+              break;
+            }
           }
-          if (Variant::equals(expr, match)) {
-            // We've matched this clause
-            matched = j;
-            break;
+          if (clause.getOpcode() == OPCODE_DEFAULT) {
+            // Remember the default clause
+            assert(defclause == 0);
+            defclause = i;
           }
         }
-        if (matched != 0) {
-          // We matched!
-          break;
-        }
-        if (clause.getOpcode() == OPCODE_DEFAULT) {
-          // Remember the default clause
-          assert(defclause == 0);
-          defclause = i;
+        if (matched == 0) {
+          // Use the default clause, if any
+          matched = defclause;
         }
       }
-      if (matched == 0) {
-        // Use the default clause, if any
-        matched = defclause;
-      }
       if (matched == 0) {
         // No clause to run
         return Variant::Void;
@@ -1200,6 +1514,32 @@ namespace {
       }
       return Variant::Void;
     }
+    bool switchDispatch(const INode& node, const Variant& match, size_t& matched) {
+      // Returns false if the case labels must be evaluated one by one
+      auto& table = static_cast<const SwitchTable&>(node.getCache([&node](IAllocator& allocator) {
+        return SwitchTable::create(allocator, node);
+      }));
+      if (!table.constant) {
+        return false;
+      }
+      if (match.isInt()) {
+        auto entry = table.ints.find(match.getInt());
+        matched = (entry == table.ints.end()) ? table.defclause : entry->second;
+        return true;
+      }
+      if (match.isString()) {
+        auto entry = table.strings.find(match.getString());
+        matched = (entry == table.strings.end()) ? table.defclause : entry->second;
+        return true;
+      }
+      if (match.isBool()) {
+        auto entry = table.bools[match.getBool()];
+        matched = (entry == 0) ? table.defclause : entry;
+        return true;
+      }
+      // Floats may still compare equal to integer labels
+      return false;
+    }
     Variant statementThrow(const INode& node) {
       assert(node.getOpcode() == OPCODE_THROW);
       assert(node.getChildren() <= 1);
@@ -1216,6 +1556,14 @@ namespace {
       return retval;
     }
     Variant statementTry(const INode& node) {
+      // Calls within 'try' statements are never in tail position because handlers may still run
+      auto* tail = this->tail;
+      this->tail = nullptr;
+      auto retval = this->statementTryCatch(node);
+      this->tail = tail;
+      return retval;
+    }
+    Variant statementTryCatch(const INode& node) {
       assert(node.getOpcode() == OPCODE_TRY);
       auto n = node.getChildren();
       assert(n >= 2);
@@ -1233,7 +1581,7 @@ namespace {
         this->updateLocation(clause);
         auto cname = this->identifier(clause.getChild(1));
         auto ctype = this->type(clause.getChild(0), cname);
-        auto retval = block.guard(this->location, ctype, cname, exception);
+        auto retval = block.guard(this->location(), ctype, cname, exception);
         if (retval.hasFlowControl()) {
           // Couldn't define the exception variable
           return this->statementTryFinally(node, retval);
@@ -1284,7 +1632,14 @@ namespace {
         }
         retval = this->executeBlock(block, node.getChild(1));
         if (retval.hasFlowControl()) {
-          return retval;
+          if (retval.is(VariantBits::Break)) {
+            // Break from the loop
+            break;
+          }
+          if (!retval.is(VariantBits::Continue)) {
+            // Some other flow control
+            return retval;
+          }
         }
       }
       return Variant::Void;
@@ -1392,19 +1747,18 @@ namespace {
     }
     Variant expressionAvalue(const INode& node) {
       assert(node.getOpcode() == OPCODE_AVALUE);
+      // Evaluate all the elements first so the array can choose its packing
       auto n = node.getChildren();
-      auto array = ObjectFactory::createVanillaArray(this->allocator, n);
+      std::vector<Variant> elements;
+      elements.reserve(n);
       for (size_t i = 0; i < n; ++i) {
         auto expr = this->expression(node.getChild(i));
         if (expr.hasFlowControl()) {
           return expr;
         }
-        expr = array->setIndex(*this, Variant(Int(i)), expr);
-        if (expr.hasFlowControl()) {
-          return expr;
-        }
+        elements.push_back(std::move(expr));
       }
-      return Variant(array);
+      return Variant(ObjectFactory::createVanillaArray(this->allocator, *this->basket, std::move(elements)));
     }
     Variant expressionFvalue(const INode& node) {
       assert(node.getOpcode() == OPCODE_FVALUE);
@@ -1442,29 +1796,34 @@ namespace {
     }
     Variant expressionCall(const INode& node) {
       assert(node.getOpcode() == OPCODE_CALL);
-      auto n = node.getChildren();
-      assert(n >= 1);
-      auto callee = this->expression(node.getChild(0));
+      auto callee = this->evaluateCallee(node);
       if (callee.hasFlowControl()) {
         return callee;
       }
-      if (!callee.hasObject()) {
-        return this->raiseNode(node, "Expected function-like expression to be an 'object', but got '", callee.getRuntimeType().toString(), "' instead");
+      return this->invoke(node, callee.getObject());
+    }
+    Variant expressionTailCall(const INode& node) {
+      // Returns 'ReturnVoid' if the call has been deferred until the current frame is discarded
+      assert(node.getOpcode() == OPCODE_CALL);
+      assert(this->tail != nullptr);
+      auto callee = this->evaluateCallee(node);
+      if (callee.hasFlowControl()) {
+        return callee;
       }
-      LocationSource before = this->location;
-      Parameters parameters;
-      for (size_t i = 1; i < n; ++i) {
-        auto& pnode = node.getChild(i);
-        auto pvalue = this->expression(pnode);
-        if (pvalue.hasFlowControl()) {
-          return pvalue;
-        }
-        this->updateLocation(pnode);
-        parameters.addPositional(this->location, std::move(pvalue));
+      auto function = callee.getObject();
+      auto* user = dynamic_cast<UserFunction*>(function.get());
+      if (user == nullptr) {
+        // Only user functions can reuse the frame
+        return this->invoke(node, function);
       }
-      auto retval = callee.getObject()->call(*this, parameters);
-      this->location = before;
-      return retval;
+      auto& tail = *this->tail;
+      tail.parameters.clear(this->current);
+      auto retval = this->evaluateArguments(node, tail.parameters);
+      if (retval.hasFlowControl()) {
+        return retval;
+      }
+      tail.function.set(user);
+      return Variant::ReturnVoid;
     }
     Variant expressionGuard(const INode& node, Block* block) {
       assert(node.getOpcode() == OPCODE_GUARD);
@@ -1479,7 +1838,7 @@ namespace {
         return vinit;
       }
       this->updateLocation(node);
-      return block->guard(this->location, vtype, vname, vinit);
+      return block->guard(this->location(), vtype, vname, vinit);
     }
     Variant expressionIdentifier(const INode& node) {
       assert(node.getOpcode() == OPCODE_IDENTIFIER);
@@ -1522,7 +1881,7 @@ namespace {
         if (OperatorProperties::from(oper).opclass == OPCLASS_COMPARE) {
           // We only support predicates for comparisons
           this->updateLocation(node);
-          return VariantFactory::createObject<PredicateFunction>(this->allocator, *this, this->location, child);
+          return VariantFactory::createObject<PredicateFunction>(this->allocator, *this, this->location(), child);
         }
       }
       return this->expression(child);
@@ -1563,6 +1922,27 @@ namespace {
       return this->raiseNode(node, "Values of type '", lhs.getRuntimeType().toString(), "' do not support properties");
     }
     // Strings
+    Variant indexedForeach(IIndexedIterable& iterable, Block& block, Target& target, const INode& statements) {
+      Variant element;
+      for (size_t index = 0; iterable.iterateIndex(*this, index, element); ++index) {
+        auto retval = target.assign(element);
+        if (retval.hasFlowControl()) {
+          return retval;
+        }
+        retval = this->executeBlock(block, statements);
+        if (retval.hasFlowControl()) {
+          if (retval.is(VariantBits::Break)) {
+            // Break from the loop
+            return Variant::Void;
+          }
+          if (!retval.is(VariantBits::Continue)) {
+            // Some other flow control
+            return retval;
+          }
+        }
+      }
+      return Variant::Void;
+    }
     Variant stringForeach(const String& string, Block& block, Target& target, const INode& statements) {
       // Iterate around the codepoints of the string
       auto* p = string.get();
@@ -1576,7 +1956,14 @@ namespace {
           }
           retval = this->executeBlock(block, statements);
           if (retval.hasFlowControl()) {
-            return retval;
+            if (retval.is(VariantBits::Break)) {
+              // Break from the loop
+              return Variant::Void;
+            }
+            if (!retval.is(VariantBits::Continue)) {
+              // Some other flow control
+              return retval;
+            }
           }
         }
       }
@@ -1779,19 +2166,39 @@ namespace {
       symbol->value.indirect(this->allocator, *this->basket);
       return symbol->value.address();
     }
-    Int operatorBinaryInt(const INode& node, Operator oper, Int lhs, Int rhs) {
+    Variant operatorBinaryInt(const INode& node, Operator oper, Int lhs, Int rhs) {
+      Int result;
       EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
       switch (oper) {
       case OPERATOR_ADD:
-        return lhs + rhs;
+        if (!IntArithmetic::add(lhs, rhs, result)) {
+          return this->raiseNode(node, "Integer overflow in addition");
+        }
+        return result;
       case OPERATOR_SUB:
-        return lhs - rhs;
+        if (!IntArithmetic::sub(lhs, rhs, result)) {
+          return this->raiseNode(node, "Integer overflow in subtraction");
+        }
+        return result;
       case OPERATOR_MUL:
-        return lhs * rhs;
+        if (!IntArithmetic::mul(lhs, rhs, result)) {
+          return this->raiseNode(node, "Integer overflow in multiplication");
+        }
+        return result;
       case OPERATOR_DIV:
-        return lhs / rhs;
+        if (rhs == 0) {
+          return this->raiseNode(node, "Division by zero in integer division");
+        }
+        if (!IntArithmetic::div(lhs, rhs, result)) {
+          return this->raiseNode(node, "Integer overflow in division");
+        }
+        return result;
       case OPERATOR_REM:
-        return lhs % rhs;
+        if (rhs == 0) {
+          return this->raiseNode(node, "Division by zero in integer remainder");
+        }
+        IntArithmetic::rem(lhs, rhs, result);
+        return result;
       }
       EGG_WARNING_SUPPRESS_SWITCH_END();
       throw this->unexpectedOperator("binary int", node);
@@ -1829,28 +2236,78 @@ namespace {
       return value;
     }
     // Error handling
-    template<typename... ARGS>
-    Variant raiseNode(const INode& node, ARGS&&... args) {
-      this->updateLocation(node);
-      return this->raiseLocation(this->location, std::forward<ARGS>(args)...);
-    }
     void updateLocation(const INode& node) {
-      auto* source = node.getLocation();
-      if (source != nullptr) {
-        this->location.line = source->line;
-        this->location.column = source->column;
+      // Just remember the node; the location itself is only constructed for diagnostics
+      this->current = &node;
+    }
+    bool proven(const INode& node) {
+      if (!this->trusted) {
+        return false;
+      }
+      // The compiler's type proof is looked up once and then cached in the node's proof byte
+      auto state = node.getProofCache();
+      if (state == 0) {
+        state = Node::isProven(node) ? ProofCache::Proven : ProofCache::Checked;
+        node.setProofCache(state);
+      }
+      return state == ProofCache::Proven;
+    }
+    LocationSource location() const {
+      LocationSource where(this->file, 0, 0);
+      if (this->current != nullptr) {
+        // Nodes built without a source location only report the resource name
+        auto* source = this->current->getLocation();
+        if (source != nullptr) {
+          where.line = source->line;
+          where.column = source->column;
+        }
       }
+      return where;
     }
     Opcode validateOpcode(const INode& node) const {
       auto opcode = node.getOpcode();
       auto& properties = OpcodeProperties::from(opcode);
       if (!properties.validate(node.getChildren(), node.getOperand() != INode::Operand::None)) {
         assert(properties.name != nullptr);
-        throw RuntimeException(this->location, "Corrupt opcode: '", properties.name, "'");
+        throw RuntimeException(this->location(), "Corrupt opcode: '", properties.name, "'");
       }
       return opcode;
     }
   public:
+    Variant evaluateCallee(const INode& node) {
+      assert(node.getOpcode() == OPCODE_CALL);
+      assert(node.getChildren() >= 1);
+      auto callee = this->expression(node.getChild(0));
+      if (!callee.hasFlowControl() && !callee.hasObject()) {
+        return this->raiseNode(node, "Expected function-like expression to be an 'object', but got '", callee.getRuntimeType().toString(), "' instead");
+      }
+      return callee;
+    }
+    Variant evaluateArguments(const INode& node, Parameters& parameters) {
+      assert(node.getOpcode() == OPCODE_CALL);
+      auto n = node.getChildren();
+      for (size_t i = 1; i < n; ++i) {
+        auto& pnode = node.getChild(i);
+        auto pvalue = this->expression(pnode);
+        if (pvalue.hasFlowControl()) {
+          return pvalue;
+        }
+        this->updateLocation(pnode);
+        parameters.addPositional(pnode, std::move(pvalue));
+      }
+      return Variant::Void;
+    }
+    Variant invoke(const INode& node, const Object& function) {
+      auto* before = this->current;
+      Parameters parameters(this->file, before);
+      auto retval = this->evaluateArguments(node, parameters);
+      if (retval.hasFlowControl()) {
+        return retval;
+      }
+      retval = function->call(*this, parameters);
+      this->current = before;
+      return retval;
+    }
     String identifier(const INode& node) {
       if (node.getOpcode() != OPCODE_IDENTIFIER) {
         throw this->unexpectedOpcode("identifier", node);
@@ -1935,25 +2392,30 @@ namespace {
       }
       EGG_WARNING_SUPPRESS_SWITCH_END();
       this->updateLocation(node);
-      throw RuntimeException(this->location, "Type constraints not yet supported"); // TODO
+      throw RuntimeException(this->location(), "Type constraints not yet supported"); // TODO
     }
     RuntimeException unexpectedOpcode(const char* expected, const INode& node) {
       this->updateLocation(node);
       auto opcode = node.getOpcode();
       auto name = OpcodeProperties::from(opcode).name;
       if (name == nullptr) {
-        return RuntimeException(this->location, "Unknown ", expected, " opcode: '<", std::to_string(opcode), ">'");
+        return RuntimeException(this->location(), "Unknown ", expected, " opcode: '<", std::to_string(opcode), ">'");
       }
-      return RuntimeException(this->location, "Unexpected ", expected, " opcode: '", name, "'");
+      return RuntimeException(this->location(), "Unexpected ", expected, " opcode: '", name, "'");
     }
     RuntimeException unexpectedOperator(const char* expected, const INode& node) {
       this->updateLocation(node);
       auto oper = node.getOperator();
       auto name = OperatorProperties::from(oper).name;
       if (name == nullptr) {
-        return RuntimeException(this->location, "Unknown ", expected, " operator: '<", std::to_string(oper), ">'");
+        return RuntimeException(this->location(), "Unknown ", expected, " operator: '<", std::to_string(oper), ">'");
       }
-      return RuntimeException(this->location, "Unexpected ", expected, " operator: '", name, "'");
+      return RuntimeException(this->location(), "Unexpected ", expected, " operator: '", name, "'");
+    }
+    template<typename... ARGS>
+    Variant raiseNode(const INode& node, ARGS&&... args) {
+      this->updateLocation(node);
+      return this->raiseLocation(this->location(), std::forward<ARGS>(args)...);
     }
     template<typename... ARGS>
     Variant raiseLocation(const LocationSource& where, ARGS&&... args) const {
@@ -2001,10 +2463,21 @@ Variant PredicateFunction::call(IExecution&, const IParameters& parameters) {
 }
 
 Variant UserFunction::call(IExecution&, const IParameters& parameters) {
+  return this->program.callUser(*this, parameters);
+}
+
+Variant Generator::call(IExecution& execution, const IParameters& parameters) {
+  if ((parameters.getPositionalCount() > 0) || (parameters.getNamedCount() > 0)) {
+    return execution.raise("Generators do not accept parameters");
+  }
+  return this->program.callGenerator(*this);
+}
+
+Variant UserFunction::execute(const IParameters& parameters) {
   auto signature = this->type->callable();
   assert(signature != nullptr);
   assert(this->captured != nullptr);
-  return this->program.executeCall(this->location, *signature, parameters, *this->block, *this->captured);
+  return this->program.executeCall(this->location, *signature, this->plan, parameters, *this->block, *this->captured);
 }
 
 Variant Target::check() const {
@@ -2019,6 +2492,14 @@ Variant Target::assign(const Variant& rhs) const {
   return this->set(rhs);
 }
 
+Variant Target::assignProven(const Variant& rhs) const {
+  if (this->flavour == Flavour::Identifier) {
+    this->program.targetSymbol(this->node, this->a.getString()).assignProven(this->program, rhs);
+    return Variant::Void;
+  }
+  return this->set(rhs);
+}
+
 Variant Target::nudge(Int rhs) const {
   assert(rhs != 0);
   Variant v;
@@ -2098,6 +2579,10 @@ egg::ovum::Variant Target::apply(const INode& opnode, Variant& lvalue, const INo
   if (result.is(VariantBits::Break)) {
     throw this->program.unexpectedOperator("target binary", opnode);
   }
+  if (result.stripFlowControl(VariantBits::Throw)) {
+    // Binary operations raise without a location, so use the operator's
+    return this->program.raiseNode(opnode, result.toString());
+  }
   return result;
 }
 
@@ -2156,19 +2641,27 @@ Variant Target::set(const Variant& value) const {
 }
 
 Block::~Block() {
+  this->reset();
+}
+
+void Block::reset() {
   // Undeclare all the names successfully declared by this block
   for (auto& i : this->declared) {
     this->program.blockUndeclare(i);
   }
+  this->declared.clear();
 }
 
-egg::ovum::Variant Block::declare(const LocationSource& source, const Type& type, const String& name, const Variant* init) {
+egg::ovum::Variant Block::declare(const LocationSource& source, const Type& type, const String& name, const Variant* init, bool proven) {
   // Keep track of names successfully declared in this block
   auto* symbol = this->program.blockDeclare(source, type, name);
   if (symbol == nullptr) {
     return this->program.raiseLocation(source, "Duplicate name in declaration: '", name, "'");
   }
-  if (init != nullptr) {
+  if (proven) {
+    assert(init != nullptr);
+    symbol->assignProven(this->program, *init);
+  } else if (init != nullptr) {
     auto retval = symbol->tryAssign(this->program, *init);
     if (!retval.isVoid()) {
       this->program.blockUndeclare(name);
@@ -2244,9 +2737,9 @@ egg::ovum::Type UserFunction::makeType(IAllocator& allocator, ProgramDefault& pr
   return Type(function.get());
 }
 
-egg::ovum::Program egg::ovum::ProgramFactory::createProgram(IAllocator& allocator, ILogger& logger) {
+egg::ovum::Program egg::ovum::ProgramFactory::createProgram(IAllocator& allocator, ILogger& logger, size_t maxCallDepth, Proofs proofs) {
   auto basket = BasketFactory::createBasket(allocator);
-  auto program = allocator.make<ProgramDefault>(*basket, logger);
+  auto program = allocator.make<ProgramDefault>(*basket, logger, maxCallDepth, proofs);
   program->addBuiltins();
   return program;
 }
@@ -8,6 +8,8 @@ namespace egg::ovum {
 
   class ProgramFactory {
   public:
-    static Program createProgram(IAllocator& allocator, ILogger& logger);
+    static constexpr size_t UnlimitedCallDepth = SIZE_MAX; // Embedders with small native stacks should set a budget
+    enum class Proofs { Trusted, Checked }; // Checked ignores the compiler's type proofs and checks every assignment
+    static Program createProgram(IAllocator& allocator, ILogger& logger, size_t maxCallDepth = UnlimitedCallDepth, Proofs proofs = Proofs::Trusted);
   };
 }
@@ -241,12 +241,98 @@ namespace {
     }
   };
 
+  class MemoryImmortal : public IMemory {
+    MemoryImmortal(const MemoryImmortal&) = delete;
+    MemoryImmortal& operator=(const MemoryImmortal&) = delete;
+  private:
+    uint8_t utf8[7];
+    uint8_t size;
+  public:
+    MemoryImmortal() : size(0) {
+    }
+    void set(const char* text, size_t bytes) {
+      // Only ASCII text is cached, so the codepoint count is the byte count
+      assert(bytes <= sizeof(this->utf8));
+      std::memcpy(this->utf8, text, bytes);
+      this->size = uint8_t(bytes);
+    }
+    virtual const uint8_t* begin() const override {
+      return this->utf8;
+    }
+    virtual const uint8_t* end() const override {
+      return this->utf8 + this->size;
+    }
+    virtual IMemory::Tag tag() const override {
+      return IMemory::Tag{ this->size };
+    }
+  };
+
+  class StringCache {
+    StringCache(const StringCache&) = delete;
+    StringCache& operator=(const StringCache&) = delete;
+  private:
+    // Process-wide strings that are never reference counted or freed
+    NotReferenceCounted<MemoryImmortal> ascii[0x80];
+    NotReferenceCounted<MemoryImmortal> decimal[100 - 10];
+    NotReferenceCounted<MemoryImmortal> keywords[3];
+    StringCache() {
+      char buffer[2];
+      for (size_t i = 0; i < 0x80; ++i) {
+        buffer[0] = char(i);
+        this->ascii[i].set(buffer, 1);
+      }
+      for (size_t i = 10; i < 100; ++i) {
+        buffer[0] = char('0' + i / 10);
+        buffer[1] = char('0' + i % 10);
+        this->decimal[i - 10].set(buffer, 2);
+      }
+      this->keywords[0].set("null", 4);
+      this->keywords[1].set("true", 4);
+      this->keywords[2].set("false", 5);
+    }
+    static const StringCache& instance() {
+      // Never destroyed, so strings with static storage duration may safely outlive it
+      alignas(StringCache) static uint8_t storage[sizeof(StringCache)];
+      static const StringCache* cache = new(storage) StringCache();
+      return *cache;
+    }
+  public:
+    static const IMemory* fromCodePoint(char32_t codepoint) {
+      return (codepoint < 0x80) ? &StringCache::instance().ascii[codepoint] : nullptr;
+    }
+    static const IMemory* fromUTF8(const uint8_t* utf8, size_t bytes) {
+      // Returns null if the text is not cached
+      switch (bytes) {
+      case 1:
+        return StringCache::fromCodePoint(utf8[0]);
+      case 2:
+        if ((utf8[0] >= '1') && (utf8[0] <= '9') && (utf8[1] >= '0') && (utf8[1] <= '9')) {
+          return &StringCache::instance().decimal[(utf8[0] - '0') * 10 + (utf8[1] - '0') - 10];
+        }
+        break;
+      case 4:
+      case 5:
+        for (auto& keyword : StringCache::instance().keywords) {
+          if ((keyword.bytes() == bytes) && (std::memcmp(keyword.begin(), utf8, bytes) == 0)) {
+            return &keyword;
+          }
+        }
+        break;
+      }
+      return nullptr;
+    }
+  };
+
   const IMemory* createContiguous(IAllocator* allocator, const void* buffer, size_t bytes, size_t codepoints = SIZE_MAX) {
     // TODO detect malformed/overlong/etc
     if ((buffer == nullptr) || (bytes == 0)) {
       return nullptr;
     }
     auto* utf8 = static_cast<const uint8_t*>(buffer);
+    auto* cached = StringCache::fromUTF8(utf8, bytes);
+    if (cached != nullptr) {
+      return cached;
+    }
     if (codepoints == SIZE_MAX) {
       codepoints = UTF8::measure(utf8, utf8 + bytes);
     }
@@ -610,8 +696,11 @@ std::string egg::ovum::String::toUTF8() const {
 }
 
 egg::ovum::String egg::ovum::String::fromCodePoint(char32_t codepoint) {
-  // OPTIMIZE
   assert(codepoint <= 0x10FFFF);
+  auto* cached = StringCache::fromCodePoint(codepoint);
+  if (cached != nullptr) {
+    return String(cached);
+  }
   auto utf8 = egg::ovum::UTF32::toUTF8(codepoint);
   return String(createContiguous(nullptr, utf8.data(), utf8.size(), 1));
 }
@@ -631,8 +720,11 @@ egg::ovum::String egg::ovum::StringBuilder::str() const {
 }
 
 egg::ovum::String egg::ovum::StringFactory::fromCodePoint(IAllocator& allocator, char32_t codepoint) {
-  // OPTIMIZE
   assert(codepoint <= 0x10FFFF);
+  auto* cached = StringCache::fromCodePoint(codepoint);
+  if (cached != nullptr) {
+    return String(cached);
+  }
   auto utf8 = egg::ovum::UTF32::toUTF8(codepoint);
   return String(createContiguous(&allocator, utf8.data(), utf8.size(), 1));
 }
@@ -1,4 +1,44 @@
 namespace egg::ovum {
+  class StringLiteral final : public IMemory {
+    StringLiteral(const StringLiteral&) = delete;
+    StringLiteral& operator=(const StringLiteral&) = delete;
+  private:
+    const char* utf8;
+    size_t bytes;
+    size_t codepoints;
+  public:
+    // Constant-initialized when declared with static storage duration, so no allocation ever takes place
+    template<size_t N>
+    constexpr explicit StringLiteral(const char (&utf8)[N]) : utf8(utf8), bytes(N - 1), codepoints(StringLiteral::measure(utf8, N - 1)) {
+      static_assert(N > 1, "Empty strings are represented by null memory");
+    }
+    virtual IHardAcquireRelease* hardAcquire() const override {
+      return const_cast<StringLiteral*>(this);
+    }
+    virtual void hardRelease() const override {
+      // Never freed
+    }
+    virtual const uint8_t* begin() const override {
+      return reinterpret_cast<const uint8_t*>(this->utf8);
+    }
+    virtual const uint8_t* end() const override {
+      return reinterpret_cast<const uint8_t*>(this->utf8 + this->bytes);
+    }
+    virtual Tag tag() const override {
+      return Tag{ this->codepoints };
+    }
+    static constexpr size_t measure(const char* utf8, size_t bytes) {
+      // Count everything except continuation bytes
+      size_t count = 0;
+      for (size_t i = 0; i < bytes; ++i) {
+        if ((uint8_t(utf8[i]) & 0xC0) != 0x80) {
+          count++;
+        }
+      }
+      return count;
+    }
+  };
+
   class String : public Memory {
   public:
     String() = default; // implicit
@@ -8,6 +48,8 @@ namespace egg::ovum {
     }
     explicit String(const IMemory* rhs) : Memory(rhs) {
     }
+    String(const StringLiteral& literal) : Memory(&literal) { // implicit
+    }
     String(const std::string& utf8, size_t codepoints = SIZE_MAX); // implicit; fallback to factory
 
     // See http://chilliant.blogspot.co.uk/2018/05/egg-strings.html
@@ -5,6 +5,6 @@ namespace egg::test {
     static egg::ovum::Module compileFile(egg::ovum::IAllocator& allocator, egg::ovum::ILogger& logger, const std::string& path);
     static egg::ovum::Module compileText(egg::ovum::IAllocator& allocator, egg::ovum::ILogger& logger, const std::string& source);
 
-    static egg::ovum::Variant run(egg::ovum::IAllocator& allocator, egg::ovum::ILogger& logger, const std::string& path);
+    static egg::ovum::Variant run(egg::ovum::IAllocator& allocator, egg::ovum::ILogger& logger, const std::string& path, size_t maxCallDepth = egg::ovum::ProgramFactory::UnlimitedCallDepth);
   };
 }
@@ -1,5 +1,7 @@
 #include "ovum/test.h"
 
+#include <thread>
+
 namespace {
   struct Header {
     void* memory;
@@ -49,6 +51,74 @@ TEST(TestMemory, AllocatorDefault) {
   allocator.destroy(header);
 }
 
+TEST(TestMemory, AllocatorUncounted) {
+  egg::ovum::AllocatorUncounted allocator;
+  const size_t align = alignof(std::max_align_t);
+  auto* memory = allocator.allocate(128, align);
+  ASSERT_NE(nullptr, memory);
+  ASSERT_TRUE(readWriteTest(memory));
+  allocator.deallocate(memory, align);
+  egg::ovum::IAllocator::Statistics stats;
+  ASSERT_FALSE(allocator.statistics(stats));
+}
+
+TEST(TestMemory, AllocatorFootprint) {
+  // The default allocator often lives on the stack, so its statistics shards live on the heap
+  ASSERT_LE(sizeof(egg::ovum::AllocatorDefault), 2 * sizeof(void*));
+  egg::ovum::AllocatorDefault allocator;
+  egg::ovum::IAllocator::Statistics stats;
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(0u, stats.totalBlocksAllocated);
+  ASSERT_EQ(0u, stats.currentBytesAllocated);
+}
+
+TEST(TestMemory, AllocatorThreaded) {
+  egg::test::Allocator allocator;
+  const size_t align = alignof(std::max_align_t);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < 8; ++t) {
+    workers.emplace_back([&allocator]() {
+      for (size_t i = 0; i < 1000; ++i) {
+        allocator.deallocate(allocator.allocate(16 + i, align), align);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  egg::ovum::IAllocator::Statistics stats;
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(8000u, stats.totalBlocksAllocated);
+  ASSERT_EQ(8u * (16u * 1000u + 999u * 1000u / 2u), stats.totalBytesAllocated);
+  ASSERT_EQ(0u, stats.currentBlocksAllocated);
+}
+
+TEST(TestMemory, AllocatorArena) {
+  egg::test::Allocator allocator;
+  {
+    egg::ovum::AllocatorArena arena{ allocator };
+    auto* small = arena.allocate(24, 8);
+    ASSERT_NE(nullptr, small);
+    ASSERT_TRUE(readWriteTest(small));
+    auto* aligned = arena.allocate(100, 64);
+    ASSERT_EQ(0u, uintptr_t(aligned) & 63u);
+    ASSERT_TRUE(readWriteTest(aligned));
+    auto* large = arena.allocate(egg::ovum::AllocatorArena::ChunkBytes * 2, 16);
+    ASSERT_NE(nullptr, large);
+    ASSERT_TRUE(readWriteTest(large));
+    arena.deallocate(small, 8);
+    egg::ovum::IAllocator::Statistics stats;
+    ASSERT_TRUE(arena.statistics(stats));
+    ASSERT_EQ(3u, stats.totalBlocksAllocated);
+    ASSERT_EQ(3u, stats.currentBlocksAllocated);
+    ASSERT_TRUE(allocator.statistics(stats));
+    ASSERT_EQ(2u, stats.currentBlocksAllocated);
+  }
+  egg::ovum::IAllocator::Statistics stats;
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(0u, stats.currentBlocksAllocated);
+}
+
 TEST(TestMemory, MemoryEmpty) {
   egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations };
   auto empty = egg::ovum::MemoryFactory::createEmpty();
@@ -449,6 +449,21 @@ TEST(TestModule, FromMemoryMinimal) {
   ASSERT_EQ(0u, grandchild->getChildren());
 }
 
+TEST(TestModule, FromMemoryFrozen) {
+  egg::test::Allocator allocator;
+  const uint8_t minimal[] = { MAGIC SECTION_CODE, OPCODE_MODULE, OPCODE_BLOCK, OPCODE_NOOP };
+  auto module = ModuleFactory::fromMemory(allocator, "<memory>", std::begin(minimal), std::end(minimal), ModuleFactory::Sharing::Frozen);
+  ASSERT_NE(nullptr, module);
+  Node root{ &module->getRootNode() };
+  ASSERT_TRUE(root->isFrozen());
+  Node child{ &root->getChild(0) };
+  ASSERT_TRUE(child->isFrozen());
+  Node grandchild{ &child->getChild(0) };
+  ASSERT_TRUE(grandchild->isFrozen());
+  ASSERT_THROW(root->setChild(0, *grandchild), std::logic_error);
+  ASSERT_EQ(OPCODE_BLOCK, root->getChild(0).getOpcode());
+}
+
 TEST(TestModule, ToBinaryStream) {
   egg::test::Allocator allocator;
   const uint8_t minimal[] = { MAGIC SECTION_CODE, OPCODE_MODULE, OPCODE_BLOCK, OPCODE_NOOP };
@@ -4,6 +4,17 @@
 
 using namespace egg::ovum;
 
+namespace {
+  class Cached final : public HardReferenceCounted<IHardAcquireRelease> {
+    Cached(const Cached&) = delete;
+    Cached& operator=(const Cached&) = delete;
+  public:
+    explicit Cached(IAllocator& allocator)
+      : HardReferenceCounted(allocator, 0) {
+    }
+  };
+}
+
 TEST(TestNode, Create0) {
   egg::test::Allocator allocator;
   auto parent = NodeFactory::create(allocator, OPCODE_NOOP);
@@ -267,3 +278,74 @@ TEST(TestNode, CreateWithAttributes2) {
   ASSERT_EQ(attributes[0].get(), &parent->getAttribute(0));
   ASSERT_EQ(attribute.get(), &parent->getAttribute(0));
 }
+
+TEST(TestNode, Cache) {
+  egg::test::Allocator allocator;
+  auto node = NodeFactory::create(allocator, OPCODE_NULL);
+  size_t built = 0;
+  auto factory = [&built](IAllocator& from) {
+    ++built;
+    return from.create<Cached>(0, from);
+  };
+  auto& first = node->getCache(factory);
+  auto& second = node->getCache(factory);
+  ASSERT_EQ(&first, &second);
+  ASSERT_EQ(1u, built);
+}
+
+TEST(TestNode, FrozenHandles) {
+  // Handles to frozen nodes keep the whole tree alive, so they may outlive the module that froze it
+  egg::test::Allocator allocator;
+  Node child;
+  {
+    auto root = NodeFactory::create(allocator, OPCODE_AVALUE, NodeFactory::create(allocator, OPCODE_NULL), NodeFactory::create(allocator, OPCODE_TRUE));
+    auto module = ModuleFactory::fromRootNode(allocator, "<frozen>", *root, ModuleFactory::Sharing::Frozen);
+    child = Node(&module->getRootNode().getChild(0));
+    ASSERT_TRUE(child->isFrozen());
+  }
+  ASSERT_EQ(OPCODE_NULL, child->getOpcode());
+  IAllocator::Statistics before;
+  ASSERT_TRUE(allocator.statistics(before));
+  child = nullptr;
+  IAllocator::Statistics after;
+  ASSERT_TRUE(allocator.statistics(after));
+  ASSERT_LT(after.currentBlocksAllocated, before.currentBlocksAllocated);
+}
+
+TEST(TestNode, FrozenShared) {
+  // Frozen trees are shared between modules and visited once however many parents share a node
+  egg::test::Allocator allocator;
+  auto leaf = NodeFactory::create(allocator, OPCODE_NULL);
+  auto root = NodeFactory::create(allocator, OPCODE_AVALUE, Node(leaf), Node(leaf));
+  auto second = ModuleFactory::fromRootNode(allocator, "<second>", *root, ModuleFactory::Sharing::Frozen);
+  {
+    auto first = ModuleFactory::fromRootNode(allocator, "<first>", *root, ModuleFactory::Sharing::Frozen);
+    auto counted = ModuleFactory::fromRootNode(allocator, "<counted>", *root);
+    ASSERT_TRUE(first->getRootNode().isFrozen());
+  }
+  ASSERT_TRUE(second->getRootNode().isFrozen());
+  ASSERT_TRUE(leaf->isFrozen());
+  ASSERT_THROW(root->setChild(0, *root), std::logic_error);
+  // Counted trees may still link to frozen nodes
+  auto outer = NodeFactory::create(allocator, OPCODE_AVALUE, Node(leaf));
+  ASSERT_FALSE(outer->isFrozen());
+  second = nullptr;
+  root = nullptr;
+  leaf = nullptr;
+  ASSERT_EQ(OPCODE_NULL, outer->getChild(0).getOpcode());
+}
+
+TEST(TestNode, FrozenProofs) {
+  // Type proofs are resolved when a tree is frozen so that threads sharing it never write to it
+  egg::test::Allocator allocator;
+  Nodes attributes{ NodeFactory::create(allocator, OPCODE_ATTRIBUTE, NodeFactory::createValue(allocator, String(Node::AttributeProven)), NodeFactory::createValue(allocator, true)) };
+  Nodes children{ NodeFactory::create(allocator, OPCODE_NULL) };
+  auto proven = NodeFactory::create(allocator, OPCODE_AVALUE, &children, &attributes);
+  auto root = NodeFactory::create(allocator, OPCODE_AVALUE, Node(proven), NodeFactory::create(allocator, OPCODE_NULL));
+  ASSERT_EQ(0u, proven->getProofCache());
+  auto module = ModuleFactory::fromRootNode(allocator, "<frozen>", *root, ModuleFactory::Sharing::Frozen);
+  ASSERT_EQ(ProofCache::Proven, proven->getProofCache());
+  ASSERT_EQ(ProofCache::Checked, root->getChild(1).getProofCache());
+  root->getChild(1).setProofCache(ProofCache::Proven);
+  ASSERT_EQ(ProofCache::Checked, root->getChild(1).getProofCache());
+}
@@ -0,0 +1,74 @@
+#include "ovum/test.h"
+#include "ovum/node.h"
+#include "ovum/module.h"
+#include "ovum/optimizer.h"
+
+using namespace egg::ovum;
+
+namespace {
+  Node createOperator(IAllocator& allocator, Opcode opcode, Operator oper, const Nodes& children) {
+    // The compiler uses operator operands rather than the integers stored in binary modules
+    return NodeFactory::create(allocator, opcode, &children, nullptr, oper);
+  }
+  std::string optimize(IAllocator& allocator, const Node& node) {
+    auto optimized = Optimizer::optimize(allocator, node);
+    return optimized.toString().toUTF8();
+  }
+}
+
+TEST(TestOptimizer, Unchanged) {
+  egg::test::Allocator allocator;
+  ModuleBuilder builder(allocator);
+  auto block = builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_NOOP));
+  auto original = builder.createModule(std::move(block));
+  auto optimized = Optimizer::optimize(allocator, original);
+  ASSERT_EQ(original.get(), optimized.get());
+}
+
+TEST(TestOptimizer, FoldArithmetic) {
+  egg::test::Allocator allocator;
+  ModuleBuilder builder(allocator);
+  auto add = createOperator(allocator, OPCODE_BINARY, OPERATOR_ADD, { builder.createValueInt(2), builder.createValueInt(3) });
+  ASSERT_EQ("(ivalue 5)", optimize(allocator, add));
+  auto mul = createOperator(allocator, OPCODE_BINARY, OPERATOR_MUL, { builder.createValueInt(2), builder.createValueFloat(0.25) });
+  ASSERT_EQ("(fvalue 0.5)", optimize(allocator, mul));
+  auto nested = createOperator(allocator, OPCODE_BINARY, OPERATOR_SUB, { builder.createValueInt(10), add });
+  ASSERT_EQ("(ivalue 5)", optimize(allocator, nested));
+  auto div = createOperator(allocator, OPCODE_BINARY, OPERATOR_DIV, { builder.createValueInt(1), builder.createValueInt(0) });
+  ASSERT_EQ("(binary / (ivalue 1) (ivalue 0))", optimize(allocator, div));
+  auto str = createOperator(allocator, OPCODE_BINARY, OPERATOR_ADD, { builder.createValueString("a"), builder.createValueInt(1) });
+  ASSERT_EQ("(binary + (svalue \"a\") (ivalue 1))", optimize(allocator, str));
+}
+
+TEST(TestOptimizer, FoldLogical) {
+  egg::test::Allocator allocator;
+  ModuleBuilder builder(allocator);
+  auto lognot = createOperator(allocator, OPCODE_UNARY, OPERATOR_LOGNOT, { builder.createNode(OPCODE_TRUE) });
+  ASSERT_EQ("(false)", optimize(allocator, lognot));
+  auto ternary = createOperator(allocator, OPCODE_TERNARY, OPERATOR_TERNARY, { lognot, builder.createValueInt(1), builder.createValueInt(2) });
+  ASSERT_EQ("(ivalue 2)", optimize(allocator, ternary));
+}
+
+TEST(TestOptimizer, PruneBranches) {
+  egg::test::Allocator allocator;
+  ModuleBuilder builder(allocator);
+  auto block = builder.createNode(OPCODE_BLOCK, {
+    builder.createNode(OPCODE_NOOP),
+    builder.createNode(OPCODE_IF, builder.createNode(OPCODE_TRUE), builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_BREAK))),
+    builder.createNode(OPCODE_IF, builder.createNode(OPCODE_FALSE), builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_BREAK))),
+    builder.createNode(OPCODE_WHILE, builder.createNode(OPCODE_FALSE), builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_BREAK))),
+    builder.createNode(OPCODE_CONTINUE)
+  });
+  ASSERT_EQ("(block (block (break)) (continue))", optimize(allocator, block));
+  auto empty = builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_NOOP), builder.createNode(OPCODE_NOOP));
+  ASSERT_EQ("(block (noop))", optimize(allocator, empty));
+}
+
+TEST(TestOptimizer, PruneElse) {
+  egg::test::Allocator allocator;
+  ModuleBuilder builder(allocator);
+  auto cond = builder.createNode(OPCODE_IDENTIFIER, builder.createValueString("x"));
+  auto inner = builder.createNode(OPCODE_IF, builder.createNode(OPCODE_FALSE), builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_BREAK)));
+  auto outer = builder.createNode(OPCODE_IF, std::move(cond), builder.createNode(OPCODE_BLOCK, builder.createNode(OPCODE_CONTINUE)), std::move(inner));
+  ASSERT_EQ("(if (identifier (svalue \"x\")) (block (continue)))", optimize(allocator, outer));
+}
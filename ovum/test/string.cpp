@@ -64,3 +64,36 @@ TEST(TestString, Assignment) {
   ASSERT_STRING("goodbye", a);
   ASSERT_STRING("", b);
 }
+
+TEST(TestString, Cached) {
+  // Single ASCII codepoints, two-digit numbers and a few keywords are shared and never allocated
+  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations };
+  auto a = egg::ovum::StringFactory::fromCodePoint(allocator, U'a');
+  ASSERT_STRING("a", a);
+  ASSERT_EQ(a.get(), egg::ovum::String("a").get());
+  ASSERT_EQ(a.get(), egg::ovum::String("cat").substring(1, 2).get());
+  auto nul = egg::ovum::StringFactory::fromCodePoint(allocator, U'\0');
+  ASSERT_EQ(1u, nul.length());
+  ASSERT_EQ(1u, nul->bytes());
+  auto digits = egg::ovum::StringFactory::fromUTF8(allocator, "42", 2);
+  ASSERT_STRING("42", digits);
+  ASSERT_EQ(digits.get(), egg::ovum::String("42").get());
+  ASSERT_EQ(egg::ovum::String("false").get(), egg::ovum::StringFactory::fromUTF8(allocator, "false", 5).get());
+  ASSERT_NE(egg::ovum::String("07").get(), egg::ovum::String("07").get());
+  ASSERT_NE(egg::ovum::String::fromCodePoint(0x00E9).get(), egg::ovum::String::fromCodePoint(0x00E9).get());
+}
+
+TEST(TestString, Literal) {
+  // Statically-allocated literals are shared without reference counting
+  static const egg::ovum::StringLiteral literal{ "caf\xC3\xA9" };
+  egg::ovum::String a{ literal };
+  ASSERT_EQ(&literal, a.get());
+  ASSERT_EQ(4u, a.length());
+  ASSERT_EQ(5u, a->bytes());
+  ASSERT_STRING("caf\xC3\xA9", a);
+  ASSERT_TRUE(a.equals(egg::ovum::String("caf\xC3\xA9")));
+  egg::ovum::Variant v{ literal };
+  ASSERT_TRUE(v.isString());
+  ASSERT_EQ(&literal, v.getString().get());
+  static_assert(egg::ovum::StringLiteral::measure("caf\xC3\xA9", 5) == 4, "Literal codepoints are counted at compile time");
+}
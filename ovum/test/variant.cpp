@@ -308,3 +308,15 @@ TEST(TestVariant, Variant) {
   ASSERT_VARIANT("goodbye", a);
   ASSERT_TRUE(b.is(Bits::Void));
 }
+
+TEST(TestVariant, InternedTypes) {
+  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations };
+  auto a = egg::ovum::Type::makeUnion(allocator, *egg::ovum::Type::Int, *egg::ovum::Type::Null);
+  auto b = egg::ovum::Type::makeUnion(allocator, *egg::ovum::Type::Null, *egg::ovum::Type::Int);
+  ASSERT_EQ(a.get(), b.get());
+  ASSERT_EQ(a.get(), egg::ovum::Type::makeBasal(allocator, egg::ovum::BasalBits::Int | egg::ovum::BasalBits::Null).get());
+  ASSERT_EQ(egg::ovum::Type::Int.get(), a->denulledType().get());
+  auto p = egg::ovum::Type::makePointer(allocator, *a);
+  ASSERT_EQ(p.get(), egg::ovum::Type::makePointer(allocator, *b).get());
+  ASSERT_STRING("int?*", p.toString());
+}
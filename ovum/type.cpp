@@ -95,14 +95,14 @@ namespace {
   };
   const OmniFunctionSignature omniFunctionSignature{};
 
-  class TypePointer : public HardReferenceCounted<TypeBase> {
-    TypePointer(const TypePointer&) = delete;
-    TypePointer& operator=(const TypePointer&) = delete;
+  class TypePointerBase : public TypeBase {
+    TypePointerBase(const TypePointerBase&) = delete;
+    TypePointerBase& operator=(const TypePointerBase&) = delete;
   private:
     Type referenced;
   public:
-    TypePointer(IAllocator& allocator, const IType& referenced)
-      : HardReferenceCounted(allocator, 0), referenced(&referenced) {
+    explicit TypePointerBase(const IType& referenced)
+      : referenced(&referenced) {
     }
     virtual BasalBits getBasalTypesLegacy() const override {
       return BasalBits::None;
@@ -120,6 +120,17 @@ namespace {
       return NodeFactory::createPointerType(memallocator, location, this->referenced);
     }
   };
+  class TypePointer : public HardReferenceCounted<TypePointerBase> {
+    TypePointer(const TypePointer&) = delete;
+    TypePointer& operator=(const TypePointer&) = delete;
+  public:
+    TypePointer(IAllocator& allocator, const IType& referenced)
+      : HardReferenceCounted(allocator, 0, referenced) {
+    }
+  };
+
+  using TypePointerInterned = NotReferenceCounted<TypePointerBase>;
+
 
   template<BasalBits BASAL>
   class TypeCommon : public NotReferenceCounted<TypeBase> {
@@ -236,14 +247,16 @@ namespace {
   };
   const TypeAnyQ typeAnyQ{};
 
-  class TypeBasal : public HardReferenceCounted<TypeBase> {
+  const IType* internBasal(BasalBits basal);
+
+  class TypeBasal : public NotReferenceCounted<TypeBase> {
     TypeBasal(const TypeBasal&) = delete;
     TypeBasal& operator=(const TypeBasal&) = delete;
   private:
     BasalBits tag;
   public:
-    TypeBasal(IAllocator& allocator, BasalBits basal)
-      : HardReferenceCounted(allocator, 0), tag(basal) {
+    explicit TypeBasal(BasalBits basal)
+      : tag(basal) {
     }
     virtual BasalBits getBasalTypesLegacy() const override {
       return this->tag;
@@ -273,7 +286,7 @@ namespace {
       auto devoided = Bits::clear(this->tag, BasalBits::Void);
       if (this->tag != devoided) {
         // We need to clear the bit
-        return Type::makeBasal(this->allocator, devoided);
+        return Type(internBasal(devoided));
       }
       return Type(this);
     }
@@ -281,7 +294,7 @@ namespace {
       auto denulled = Bits::clear(this->tag, BasalBits::Null);
       if (this->tag != denulled) {
         // We need to clear the bit
-        return Type::makeBasal(this->allocator, denulled);
+        return Type(internBasal(denulled));
       }
       return Type(this);
     }
@@ -311,6 +324,54 @@ namespace {
     }
   };
 
+  class TypeInterner {
+    TypeInterner(const TypeInterner&) = delete;
+    TypeInterner& operator=(const TypeInterner&) = delete;
+  public:
+    static constexpr size_t Combinations = size_t(BasalBits::AnyQ | BasalBits::Void) + 1;
+  private:
+    // Every combination of basal bits (and a pointer to it) has exactly one immortal instance, so equality is identity
+    const IType* basals[Combinations];
+    const IType* pointers[Combinations];
+    std::list<TypeBasal> owned;
+    std::list<TypePointerInterned> pointees;
+    TypeInterner() {
+      this->basals[0] = nullptr;
+      this->pointers[0] = nullptr;
+      for (size_t i = 1; i < Combinations; ++i) {
+        auto basal = BasalBits(i);
+        auto* common = Type::getBasalType(basal);
+        if (common == nullptr) {
+          common = &this->owned.emplace_back(basal);
+        }
+        this->basals[i] = common;
+        this->pointers[i] = &this->pointees.emplace_back(*common);
+      }
+    }
+  public:
+    const IType* basal(BasalBits basal) const {
+      auto index = size_t(basal);
+      assert((index > 0) && (index < Combinations));
+      return this->basals[index];
+    }
+    const IType* pointer(const IType& pointee) const {
+      // Returns null if the pointee is not itself interned
+      auto index = size_t(pointee.getBasalTypesLegacy());
+      if ((index > 0) && (index < Combinations) && (this->basals[index] == &pointee)) {
+        return this->pointers[index];
+      }
+      return nullptr;
+    }
+    static const TypeInterner& instance() {
+      static const TypeInterner interner;
+      return interner;
+    }
+  };
+
+  const IType* internBasal(BasalBits basal) {
+    return TypeInterner::instance().basal(basal);
+  }
+
   const char* getBasalComponent(BasalBits basal) {
     switch (basal) {
     case BasalBits::None:
@@ -358,13 +419,9 @@ std::string egg::ovum::Type::getBasalString(BasalBits basal) {
   return getBasalString(Bits::clear(basal, head)) + '|' + component;
 }
 
-egg::ovum::Type egg::ovum::Type::makeBasal(IAllocator& allocator, BasalBits basal) {
-  // Try to use non-reference-counted globals
-  auto* common = Type::getBasalType(basal);
-  if (common != nullptr) {
-    return Type(common);
-  }
-  return allocator.make<TypeBasal, Type>(basal);
+egg::ovum::Type egg::ovum::Type::makeBasal(IAllocator&, BasalBits basal) {
+  // All basal types are non-reference-counted globals
+  return Type(internBasal(basal));
 }
 
 egg::ovum::Type egg::ovum::Type::makeUnion(IAllocator& allocator, const IType& a, const IType& b) {
@@ -378,7 +435,11 @@ egg::ovum::Type egg::ovum::Type::makeUnion(IAllocator& allocator, const IType& a
 }
 
 egg::ovum::Type egg::ovum::Type::makePointer(IAllocator& allocator, const IType& pointee) {
-  // Return a new type 'Type*'
+  // Pointers to basal types are interned; others return a new type 'Type*'
+  auto* interned = TypeInterner::instance().pointer(pointee);
+  if (interned != nullptr) {
+    return Type(interned);
+  }
   return allocator.make<TypePointer, Type>(pointee);
 }
 
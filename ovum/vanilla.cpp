@@ -1,12 +1,20 @@
 #include "ovum/ovum.h"
 #include "ovum/node.h"
 #include "ovum/dictionary.h"
+#include "ovum/packed.h"
 
 #include <stdexcept>
 
 namespace {
   using namespace egg::ovum;
 
+  const StringLiteral literalMessage{ "message" };
+  const StringLiteral literalFile{ "file" };
+  const StringLiteral literalLine{ "line" };
+  const StringLiteral literalColumn{ "column" };
+  const StringLiteral literalEmptyArray{ "[]" };
+  const StringLiteral literalEmptyObject{ "{}" };
+
   class VanillaBase : public SoftReferenceCounted<IObject> {
     VanillaBase(const VanillaBase&) = delete;
     VanillaBase& operator=(const VanillaBase&) = delete;
@@ -16,34 +24,24 @@ namespace {
     }
   };
 
-  class VanillaArray : public VanillaBase {
+  class VanillaArray : public VanillaBase, public IIndexedIterable {
     VanillaArray(const VanillaArray&) = delete;
     VanillaArray& operator=(const VanillaArray&) = delete;
     friend class VanillaArrayIterator;
   private:
-    std::vector<Variant> values;
+    PackedArray elements;
   public:
-    VanillaArray(IAllocator& allocator, size_t size)
-      : VanillaBase(allocator) {
-      this->values.resize(size);
+    VanillaArray(IAllocator& allocator, IBasket& basket, PackedArray&& elements)
+      : VanillaBase(allocator),
+        elements(std::move(elements)) {
+      basket.take(*this);
+      this->elements.soften(basket);
     }
     virtual void softVisitLinks(const Visitor& visitor) const override {
-      for (auto& value : this->values) {
-        value.softVisitLink(visitor);
-      }
+      this->elements.softVisitLinks(visitor);
     }
     virtual Variant toString() const override {
-      if (this->values.empty()) {
-        return "[]";
-      }
-      StringBuilder sb;
-      char separator = '[';
-      for (auto& value : this->values) {
-        sb.add(separator, value.toString());
-        separator = ',';
-      }
-      sb.add(']');
-      return sb.str();
+      return this->elements.toString();
     }
     virtual Type getRuntimeType() const override {
       return Type::Object; // WIBBLE
@@ -51,12 +49,7 @@ namespace {
     virtual Variant call(IExecution& execution, const IParameters&) override {
       return execution.raiseFormat("Arrays cannot be called like functions");
     }
-    virtual Variant getProperty(IExecution& execution, const String& property) override {
-      if (property.equals("length")) {
-        return Variant(Int(this->values.size()));
-      }
-      return execution.raiseFormat("Arrays do not support property '", property, "'");
-    }
+    virtual Variant getProperty(IExecution& execution, const String& property) override;
     virtual Variant setProperty(IExecution& execution, const String& property, const Variant& value) override {
       if (property.equals("length")) {
         if (!value.isInt()) {
@@ -66,7 +59,7 @@ namespace {
         if ((n < 0) || (n >= 0x7FFFFFFF)) {
           return execution.raiseFormat("Invalid array length: ", n);
         }
-        this->values.resize(size_t(n), egg::ovum::Variant::Null);
+        this->elements.resize(size_t(n));
         return Variant::Void;
       }
       return execution.raiseFormat("Arrays do not support property '", property, "'");
@@ -77,10 +70,10 @@ namespace {
       }
       auto i = index.getInt();
       auto u = size_t(i);
-      if (u >= this->values.size()) {
-        return execution.raiseFormat("Invalid array index for an array with ", this->values.size(), " element(s): ", i);
+      if (u >= this->elements.size()) {
+        return execution.raiseFormat("Invalid array index for an array with ", this->elements.size(), " element(s): ", i);
       }
-      return this->values[u].direct();
+      return this->elements.get(u).direct();
     }
     virtual Variant setIndex(IExecution& execution, const Variant& index, const Variant& value) override {
       if (!index.isInt()) {
@@ -88,18 +81,83 @@ namespace {
       }
       auto i = index.getInt();
       auto u = size_t(i);
-      if (u >= this->values.size()) {
-        return execution.raiseFormat("Invalid array index for an array with ", this->values.size(), " element(s): ", i);
+      if (u >= this->elements.size()) {
+        return execution.raiseFormat("Invalid array index for an array with ", this->elements.size(), " element(s): ", i);
+      }
+      auto* e = this->elements.set(u, value);
+      if (e != nullptr) {
+        e->soften(*this->basket);
       }
-      auto& e = this->values[u];
-      e = value;
-      e.soften(*this->basket);
       return Variant::Void;
     }
     virtual Variant iterate(IExecution& execution) override;
+    Variant invoke(IExecution& execution, PackedArray::Method method, const IParameters& parameters) {
+      auto& basket = execution.getBasket();
+      auto factory = [this, &basket](PackedArray&& result) {
+        return Variant(ObjectFactory::create<VanillaArray>(this->allocator, basket, std::move(result)));
+      };
+      auto retval = (this->elements.*method)(execution, parameters, factory);
+      if (PackedArray::storesValues(method)) {
+        // Bulk modifications may have stored values that are not yet soft
+        this->elements.soften(*this->basket);
+      }
+      return retval;
+    }
+    virtual bool iterateIndex(IExecution&, size_t index, Variant& element) override {
+      // Elements appended during iteration will be visited
+      if (index < this->elements.size()) {
+        element = this->elements.get(index);
+        return true;
+      }
+      return false;
+    }
+  };
+
+  class VanillaArrayMethod : public VanillaBase {
+    VanillaArrayMethod(const VanillaArrayMethod&) = delete;
+    VanillaArrayMethod& operator=(const VanillaArrayMethod&) = delete;
+  private:
+    HardPtr<VanillaArray> array;
+    String name;
+    PackedArray::Method method;
+  public:
+    VanillaArrayMethod(IAllocator& allocator, VanillaArray& array, const String& name, PackedArray::Method method)
+      : VanillaBase(allocator),
+        array(&array),
+        name(name),
+        method(method) {
+      assert(method != nullptr);
+    }
+    virtual void softVisitLinks(const Visitor&) const override {
+      // There are no soft links to visit
+    }
+    virtual Variant toString() const override {
+      return StringBuilder::concat("<array.", this->name, '>');
+    }
+    virtual Type getRuntimeType() const override {
+      return Type::Object; // WIBBLE
+    }
+    virtual Variant call(IExecution& execution, const IParameters& parameters) override {
+      return this->array->invoke(execution, this->method, parameters);
+    }
+    virtual Variant getProperty(IExecution& execution, const String& property) override {
+      return execution.raiseFormat("Array methods do not support properties such as '", property, "'");
+    }
+    virtual Variant setProperty(IExecution& execution, const String& property, const Variant&) override {
+      return execution.raiseFormat("Array methods do not support properties such as '", property, "'");
+    }
+    virtual Variant getIndex(IExecution& execution, const Variant&) override {
+      return execution.raiseFormat("Array methods do not support indexing with '[]'");
+    }
+    virtual Variant setIndex(IExecution& execution, const Variant&, const Variant&) override {
+      return execution.raiseFormat("Array methods do not support indexing with '[]'");
+    }
+    virtual Variant iterate(IExecution& execution) override {
+      return execution.raiseFormat("Array methods do not support iteration");
+    }
   };
 
-  class VanillaKeyValue : public VanillaBase {
+  class VanillaKeyValue : public VanillaBase, public IIndexedIterable {
     VanillaKeyValue(const VanillaKeyValue&) = delete;
     VanillaKeyValue& operator=(const VanillaKeyValue&) = delete;
     friend class VanillaKeyValueIterator;
@@ -150,9 +208,20 @@ namespace {
       return execution.raiseFormat("Key-value object does not support setting properties with '[]'");
     }
     virtual Variant iterate(IExecution& execution) override;
+    virtual bool iterateIndex(IExecution&, size_t index, Variant& element) override {
+      switch (index) {
+      case 0:
+        element = this->key;
+        return true;
+      case 1:
+        element = this->value;
+        return true;
+      }
+      return false;
+    }
   };
 
-  class VanillaObject : public VanillaBase {
+  class VanillaObject : public VanillaBase, public IIndexedIterable {
     VanillaObject(const VanillaObject&) = delete;
     VanillaObject& operator=(const VanillaObject&) = delete;
     friend class VanillaObjectIterator;
@@ -169,7 +238,7 @@ namespace {
     }
     virtual Variant toString() const override {
       if (this->values.empty()) {
-        return "{}";
+        return literalEmptyObject;
       }
       StringBuilder sb;
       char separator = '{';
@@ -208,34 +277,45 @@ namespace {
       return this->values.addOrUpdate(property, value);
     }
     virtual Variant iterate(IExecution& execution) override;
+    virtual bool iterateIndex(IExecution& execution, size_t index, Variant& element) override {
+      // Each element is a new key-value object
+      if (index < this->values.length()) {
+        auto kv = this->values.getByIndex(index);
+        element = ObjectFactory::createVanillaKeyValue(this->allocator, execution.getBasket(), kv.first, kv.second);
+        return true;
+      }
+      return false;
+    }
   };
 
   class VanillaException : public VanillaObject {
     VanillaException(const VanillaException&) = delete;
     VanillaException& operator=(const VanillaException&) = delete;
+  private:
+    // The properties are only added to the dictionary if the script inspects the exception
+    LocationSource location;
+    String message;
+    bool materialized;
   public:
     VanillaException(IAllocator& allocator, const LocationSource& location, const String& message)
-      : VanillaObject(allocator) {
-      this->values.addUnique("message", message);
-      if (!location.file.empty()) {
-        this->values.addUnique("file", location.file);
-      }
-      if ((location.line > 0) || (location.column > 0)) {
-        this->values.addUnique("line", Int(location.line));
-      }
-      if (location.column > 0) {
-        this->values.addUnique("column", Int(location.column));
-      }
+      : VanillaObject(allocator),
+        location(location),
+        message(message),
+        materialized(false) {
     }
     virtual Variant toString() const override {
+      if (!this->materialized) {
+        // Cheap path for exceptions that are only ever logged
+        return this->format(this->location, this->message);
+      }
       StringBuilder sb;
       Variant part;
-      if (this->values.tryGet("file", part)) {
+      if (this->values.tryGet(literalFile, part)) {
         sb.add(part.toString());
       }
-      if (this->values.tryGet("line", part)) {
+      if (this->values.tryGet(literalLine, part)) {
         sb.add('(', part.toString());
-        if (this->values.tryGet("column", part)) {
+        if (this->values.tryGet(literalColumn, part)) {
           sb.add(',', part.toString());
         }
         sb.add(')');
@@ -243,13 +323,64 @@ namespace {
       if (!sb.empty()) {
         sb.add(':', ' ');
       }
-      if (this->values.tryGet("message", part)) {
+      if (this->values.tryGet(literalMessage, part)) {
         sb.add(part.toString());
       } else {
         sb.add("Unknown exception");
       }
       return sb.str();
     }
+    virtual Variant getProperty(IExecution& execution, const String& property) override {
+      return this->materialize().VanillaObject::getProperty(execution, property);
+    }
+    virtual Variant setProperty(IExecution& execution, const String& property, const Variant& value) override {
+      return this->materialize().VanillaObject::setProperty(execution, property, value);
+    }
+    virtual Variant getIndex(IExecution& execution, const Variant& index) override {
+      return this->materialize().VanillaObject::getIndex(execution, index);
+    }
+    virtual Variant setIndex(IExecution& execution, const Variant& index, const Variant& value) override {
+      return this->materialize().VanillaObject::setIndex(execution, index, value);
+    }
+    virtual Variant iterate(IExecution& execution) override {
+      return this->materialize().VanillaObject::iterate(execution);
+    }
+    virtual bool iterateIndex(IExecution& execution, size_t index, Variant& element) override {
+      return this->materialize().VanillaObject::iterateIndex(execution, index, element);
+    }
+  private:
+    VanillaException& materialize() {
+      if (!this->materialized) {
+        this->values.addUnique(literalMessage, this->message);
+        if (!this->location.file.empty()) {
+          this->values.addUnique(literalFile, this->location.file);
+        }
+        if ((this->location.line > 0) || (this->location.column > 0)) {
+          this->values.addUnique(literalLine, Int(this->location.line));
+        }
+        if (this->location.column > 0) {
+          this->values.addUnique(literalColumn, Int(this->location.column));
+        }
+        this->materialized = true;
+      }
+      return *this;
+    }
+    static String format(const LocationSource& location, const String& message) {
+      if (location.file.empty() && (location.line == 0) && (location.column == 0)) {
+        return message;
+      }
+      StringBuilder sb;
+      sb.add(location.file);
+      if ((location.line > 0) || (location.column > 0)) {
+        sb.add('(', location.line);
+        if (location.column > 0) {
+          sb.add(',', location.column);
+        }
+        sb.add(')');
+      }
+      sb.add(':', ' ', message);
+      return sb.str();
+    }
   };
 
   class VanillaIteratorBase : public VanillaBase {
@@ -309,14 +440,14 @@ namespace {
         // Already completed
         return Variant::Void;
       }
-      auto& values = this->container->values;
+      auto& elements = this->container->elements;
       auto i = this->index++;
-      if (i >= values.size()) {
+      if (i >= elements.size()) {
         // Just completed
         this->index = SIZE_MAX;
         return Variant::Void;
       }
-      return values[i];
+      return elements.get(i);
     }
   };
 
@@ -384,6 +515,17 @@ namespace {
   };
 }
 
+egg::ovum::Variant VanillaArray::getProperty(IExecution& execution, const String& property) {
+  if (property.equals("length")) {
+    return Variant(Int(this->elements.size()));
+  }
+  auto method = PackedArray::findMethod(property);
+  if (method != nullptr) {
+    return VariantFactory::createObject<VanillaArrayMethod>(this->allocator, *this, property, method);
+  }
+  return execution.raiseFormat("Arrays do not support property '", property, "'");
+}
+
 egg::ovum::Variant VanillaArray::iterate(IExecution&) {
   return VariantFactory::createObject<VanillaArrayIterator>(this->allocator, *this);
 }
@@ -396,8 +538,8 @@ egg::ovum::Variant VanillaObject::iterate(IExecution&) {
   return VariantFactory::createObject<VanillaObjectIterator>(this->allocator, *this);
 }
 
-egg::ovum::Object egg::ovum::ObjectFactory::createVanillaArray(IAllocator& allocator, size_t size) {
-  return ObjectFactory::create<VanillaArray>(allocator, size);
+egg::ovum::Object egg::ovum::ObjectFactory::createVanillaArray(IAllocator& allocator, IBasket& basket, std::vector<Variant>&& elements) {
+  return ObjectFactory::create<VanillaArray>(allocator, basket, PackedArray(std::move(elements)));
 }
 
 egg::ovum::Object egg::ovum::ObjectFactory::createVanillaException(IAllocator& allocator, const LocationSource& location, const String& message) {
@@ -155,6 +155,11 @@ namespace egg::ovum {
       assert(this->hasAny(VariantBits::Int));
       return this->u.i;
     }
+    void setInt(Int value) {
+      // Overwrite an existing 'int' in place
+      assert(this->isInt());
+      this->u.i = value;
+    }
     // Float (support automatic promotion of 32-bit IEEE)
     Variant(float value) : VariantKind(VariantBits::Float) {
       this->u.f = value;
@@ -169,6 +174,11 @@ namespace egg::ovum {
       assert(this->hasAny(VariantBits::Float));
       return this->u.f;
     }
+    void setFloat(Float value) {
+      // Overwrite an existing 'float' in place
+      assert(this->isFloat());
+      this->u.f = value;
+    }
     // String
     Variant(const String& value) : VariantKind(VariantBits::String | VariantBits::Hard) {
       this->u.s = String::hardAcquire(value.get());
@@ -179,6 +189,10 @@ namespace egg::ovum {
       this->u.s = Variant::acquireFallbackString(value.data(), value.size());
       assert(this->validate());
     }
+    Variant(const StringLiteral& value) : VariantKind(VariantBits::String | VariantBits::Hard) {
+      this->u.s = String::hardAcquire(&value);
+      assert(this->validate());
+    }
     Variant(const char* value) : VariantKind(VariantBits::String | VariantBits::Hard) {
       if (value == nullptr) {
         this->kind = VariantBits::Null;
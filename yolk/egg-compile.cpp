@@ -6,6 +6,53 @@
 #include "yolk/egg-engine.h"
 #include "yolk/egg-program.h"
 
+namespace {
+  bool provenValue(const egg::ovum::INode& node) {
+    // Only trust expressions whose runtime type cannot stray from their prepared type
+    // Identifiers are not trusted because variables may be declared without an initializer
+    EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+    switch (node.getOpcode()) {
+    case egg::ovum::OPCODE_IVALUE:
+    case egg::ovum::OPCODE_FVALUE:
+    case egg::ovum::OPCODE_SVALUE:
+    case egg::ovum::OPCODE_TRUE:
+    case egg::ovum::OPCODE_FALSE:
+    case egg::ovum::OPCODE_NULL:
+    case egg::ovum::OPCODE_COMPARE:
+      return true;
+    case egg::ovum::OPCODE_UNARY:
+      switch (node.getOperator()) {
+      case egg::ovum::OPERATOR_LOGNOT:
+      case egg::ovum::OPERATOR_NEG:
+      case egg::ovum::OPERATOR_BITNOT:
+        return provenValue(node.getChild(0));
+      }
+      break;
+    case egg::ovum::OPCODE_BINARY:
+      if (node.getOperator() != egg::ovum::OPERATOR_IFNULL) {
+        return provenValue(node.getChild(0)) && provenValue(node.getChild(1));
+      }
+      break;
+    }
+    EGG_WARNING_SUPPRESS_SWITCH_END();
+    return false;
+  }
+
+  bool provenAssignment(const egg::ovum::Type& ltype, const egg::yolk::IEggProgramNode& rvalue, const egg::ovum::INode& compiled) {
+    // Values of simple types that the target accepts without promotion need no runtime check
+    constexpr auto simple = egg::ovum::BasalBits::Null | egg::ovum::BasalBits::Bool | egg::ovum::BasalBits::Int | egg::ovum::BasalBits::Float | egg::ovum::BasalBits::String;
+    auto rtype = rvalue.getType();
+    if ((ltype == nullptr) || (rtype == nullptr) || !provenValue(compiled)) {
+      return false;
+    }
+    auto rbasal = rtype->getBasalTypesLegacy();
+    if ((rbasal == egg::ovum::BasalBits::None) || (egg::ovum::Bits::clear(rbasal, simple) != egg::ovum::BasalBits::None)) {
+      return false;
+    }
+    return egg::ovum::Bits::hasAllSet(ltype->getBasalTypesLegacy(), rbasal);
+  }
+}
+
 egg::yolk::EggProgramCompilerNode& egg::yolk::EggProgramCompilerNode::add(const egg::ovum::Node& child) {
   this->nodes.push_back(child);
   return *this;
@@ -37,13 +84,21 @@ egg::yolk::EggProgramCompilerNode& egg::yolk::EggProgramCompilerNode::add(const
   return *this;
 }
 
+egg::yolk::EggProgramCompilerNode& egg::yolk::EggProgramCompilerNode::attribute(const egg::ovum::String& key, egg::ovum::Node&& value) {
+  auto& allocator = this->compiler.context.allocator();
+  auto name = egg::ovum::NodeFactory::create(allocator, egg::ovum::OPCODE_SVALUE, nullptr, nullptr, key);
+  this->attributes.emplace_back(egg::ovum::NodeFactory::create(allocator, egg::ovum::OPCODE_ATTRIBUTE, std::move(name), std::move(value)));
+  return *this;
+}
+
 egg::ovum::Node egg::yolk::EggProgramCompilerNode::build() {
   if (!this->failed) {
     if (this->nodes.empty() && (this->opcode == egg::ovum::OPCODE_BLOCK)) {
       // Handle the special case of empty blocks needing a noop
       this->add(this->compiler.create(this->location, egg::ovum::OPCODE_NOOP, nullptr));
     }
-    return this->compiler.create(this->location, this->opcode, &this->nodes);
+    auto* attributes = this->attributes.empty() ? nullptr : &this->attributes;
+    return this->compiler.create(this->location, this->opcode, &this->nodes, attributes);
   }
   return nullptr;
 }
@@ -154,7 +209,7 @@ egg::ovum::Node egg::yolk::EggProgramCompiler::assign(const egg::ovum::LocationS
   case EggProgramAssign::Minus: return this->operation(location, egg::ovum::OPCODE_MUTATE, egg::ovum::OPERATOR_SUB, a, b);
   case EggProgramAssign::Divide: return this->operation(location, egg::ovum::OPCODE_MUTATE, egg::ovum::OPERATOR_DIV, a, b);
   case EggProgramAssign::ShiftLeft: return this->operation(location, egg::ovum::OPCODE_MUTATE, egg::ovum::OPERATOR_SHIFTL, a, b);
-  case EggProgramAssign::Equal: return this->statement(location, egg::ovum::OPCODE_ASSIGN, a, b);
+  case EggProgramAssign::Equal: return this->assignment(location, a, b);
   case EggProgramAssign::ShiftRight: return this->operation(location, egg::ovum::OPCODE_MUTATE, egg::ovum::OPERATOR_SHIFTR, a, b);
   case EggProgramAssign::ShiftRightUnsigned: return this->operation(location, egg::ovum::OPCODE_MUTATE, egg::ovum::OPERATOR_SHIFTU, a, b);
   case EggProgramAssign::NullCoalescing: return this->operation(location, egg::ovum::OPCODE_MUTATE, egg::ovum::OPERATOR_IFNULL, a, b);
@@ -165,6 +220,35 @@ egg::ovum::Node egg::yolk::EggProgramCompiler::assign(const egg::ovum::LocationS
   return this->raise("Unsupported assignment operator");
 }
 
+egg::ovum::Node egg::yolk::EggProgramCompiler::assignment(const egg::ovum::LocationSource& location, const IEggProgramNode& a, const IEggProgramNode& b) {
+  auto lvalue = a.compile(*this);
+  auto rvalue = b.compile(*this);
+  if ((lvalue == nullptr) || (rvalue == nullptr)) {
+    return nullptr;
+  }
+  EggProgramCompilerNode node(*this, location, egg::ovum::OPCODE_ASSIGN);
+  if ((lvalue->getOpcode() == egg::ovum::OPCODE_IDENTIFIER) && provenAssignment(a.getType(), b, *rvalue)) {
+    node.attribute(egg::ovum::Node::AttributeProven, egg::ovum::NodeFactory::createValue(this->context.allocator(), true));
+  }
+  return node.add(lvalue, rvalue).build();
+}
+
+egg::ovum::Node egg::yolk::EggProgramCompiler::declare(const egg::ovum::LocationSource& location, const egg::ovum::String& name, const egg::ovum::Type& vtype, const IEggProgramNode* init) {
+  EggProgramCompilerNode node(*this, location, egg::ovum::OPCODE_DECLARE);
+  node.add(this->type(location, vtype), this->identifier(location, name));
+  if (init != nullptr) {
+    auto rvalue = init->compile(*this);
+    if (rvalue == nullptr) {
+      return nullptr;
+    }
+    if (provenAssignment(vtype, *init, *rvalue)) {
+      node.attribute(egg::ovum::Node::AttributeProven, egg::ovum::NodeFactory::createValue(this->context.allocator(), true));
+    }
+    node.add(rvalue);
+  }
+  return node.build();
+}
+
 egg::ovum::Node egg::yolk::EggProgramCompiler::predicate(const egg::ovum::LocationSource& location, EggProgramBinary op, const IEggProgramNode& a, const IEggProgramNode& b) {
   auto child = this->binary(location, op, a, b);
   return this->expression(location, egg::ovum::OPCODE_PREDICATE, child);
@@ -182,6 +266,7 @@ egg::ovum::ILogger::Severity egg::yolk::EggProgram::compile(IEggEngineCompilatio
   EggProgramCompiler compiler(compilation);
   auto node = this->root->compile(compiler);
   if (node != nullptr) {
+    node = egg::ovum::Optimizer::optimize(compilation.allocator(), node);
     out = egg::ovum::ModuleFactory::fromRootNode(compilation.allocator(), this->resource, *node);
     return egg::ovum::ILogger::Severity::None;
   }
@@ -6,6 +6,8 @@
 #include "yolk/egg-engine.h"
 #include "yolk/egg-program.h"
 
+#include <thread>
+
 namespace {
   using namespace egg::yolk;
 
@@ -22,14 +24,82 @@ namespace {
     return egg::ovum::ILogger::Severity::Error;
   }
 
+  class EggEngineBatchLogger : public egg::ovum::ILogger {
+    EGG_NO_COPY(EggEngineBatchLogger);
+  private:
+    std::string& diagnostics;
+  public:
+    explicit EggEngineBatchLogger(std::string& diagnostics)
+      : diagnostics(diagnostics) {
+    }
+    virtual void log(Source, Severity severity, const std::string& message) override {
+      switch (severity) {
+      case Severity::Debug:
+        this->diagnostics += "<DEBUG>";
+        break;
+      case Severity::Verbose:
+        this->diagnostics += "<VERBOSE>";
+        break;
+      case Severity::Warning:
+        this->diagnostics += "<WARNING>";
+        break;
+      case Severity::Error:
+        this->diagnostics += "<ERROR>";
+        break;
+      case Severity::None:
+      case Severity::Information:
+        break;
+      }
+      this->diagnostics += message;
+      this->diagnostics += '\n';
+    }
+  };
+
+  void compileBatchFile(EggEngineBatchResult& result) {
+    // Nothing is shared between files, so workers need no synchronization beyond claiming indices
+    egg::ovum::AllocatorDefault allocator;
+    auto logger = std::make_shared<EggEngineBatchLogger>(result.diagnostics);
+    egg::ovum::Module module;
+    result.severity = captureExceptions(egg::ovum::ILogger::Source::Compiler, *logger, [&]{
+      FileTextStream stream(result.path);
+      auto engine = EggEngineFactory::createEngineFromTextStream(stream);
+      auto preparation = EggEngineFactory::createPreparationContext(allocator, logger);
+      auto severity = engine->prepare(*preparation);
+      if (severity == egg::ovum::ILogger::Severity::Error) {
+        return severity;
+      }
+      auto compilation = EggEngineFactory::createCompilationContext(allocator, logger);
+      return std::max(severity, engine->compile(*compilation, module));
+    });
+    if ((result.severity != egg::ovum::ILogger::Severity::Error) && (module != nullptr)) {
+      std::ostringstream oss;
+      egg::ovum::ModuleFactory::toBinaryStream(*module, oss);
+      result.module = oss.str();
+    }
+  }
+
+  void findSourceFiles(const std::string& directory, std::vector<std::string>& found) {
+    for (auto& entry : File::readDirectory(directory)) {
+      auto path = directory + '/' + entry;
+      if (String::endsWith(entry, ".egg")) {
+        found.push_back(path);
+      } else {
+        // Non-directories simply yield no entries
+        findSourceFiles(path, found);
+      }
+    }
+  }
+
   class EggEngineContext : public IEggEnginePreparationContext, public IEggEngineExecutionContext, public IEggEngineCompilationContext {
     EGG_NO_COPY(EggEngineContext);
   private:
     egg::ovum::IAllocator& mallocator;
     std::shared_ptr<egg::ovum::ILogger> logger;
+    size_t threads;
+    size_t depth;
   public:
-    EggEngineContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger)
-      : mallocator(allocator), logger(logger) {
+    EggEngineContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger, size_t concurrency = 1, size_t maxCallDepth = egg::ovum::ProgramFactory::UnlimitedCallDepth)
+      : mallocator(allocator), logger(logger), threads(concurrency), depth(maxCallDepth) {
       assert(logger != nullptr);
     }
     virtual void log(egg::ovum::ILogger::Source source, egg::ovum::ILogger::Severity severity, const std::string& message) override {
@@ -38,6 +108,12 @@ namespace {
     virtual egg::ovum::IAllocator& allocator() const override {
       return this->mallocator;
     }
+    virtual size_t concurrency() const override {
+      return this->threads;
+    }
+    virtual size_t maxCallDepth() const override {
+      return this->depth;
+    }
   };
 
   class EggEngineParsed : public IEggEngine {
@@ -111,12 +187,12 @@ namespace {
   };
 }
 
-std::shared_ptr<IEggEnginePreparationContext> egg::yolk::EggEngineFactory::createPreparationContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger) {
-  return std::make_shared<EggEngineContext>(allocator, logger);
+std::shared_ptr<IEggEnginePreparationContext> egg::yolk::EggEngineFactory::createPreparationContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger, size_t concurrency) {
+  return std::make_shared<EggEngineContext>(allocator, logger, concurrency);
 }
 
-std::shared_ptr<IEggEngineExecutionContext> egg::yolk::EggEngineFactory::createExecutionContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger) {
-  return std::make_shared<EggEngineContext>(allocator, logger);
+std::shared_ptr<IEggEngineExecutionContext> egg::yolk::EggEngineFactory::createExecutionContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger, size_t maxCallDepth) {
+  return std::make_shared<EggEngineContext>(allocator, logger, 1, maxCallDepth);
 }
 
 std::shared_ptr<IEggEngineCompilationContext> egg::yolk::EggEngineFactory::createCompilationContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger) {
@@ -130,3 +206,46 @@ std::shared_ptr<egg::yolk::IEggEngine> egg::yolk::EggEngineFactory::createEngine
 std::shared_ptr<egg::yolk::IEggEngine> egg::yolk::EggEngineFactory::createEngineFromTextStream(TextStream& stream) {
   return std::make_shared<EggEngineTextStream>(stream);
 }
+
+egg::ovum::ILogger::Severity egg::yolk::EggEngineFactory::compileBatch(const std::vector<std::string>& paths, std::vector<EggEngineBatchResult>& results, size_t concurrency) {
+  results.clear();
+  results.resize(paths.size());
+  for (size_t index = 0; index < paths.size(); ++index) {
+    results[index].path = paths[index];
+    results[index].severity = egg::ovum::ILogger::Severity::None;
+  }
+  if (concurrency == 0) {
+    concurrency = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+  }
+  concurrency = std::min(concurrency, paths.size());
+  std::atomic<size_t> next{ 0 };
+  auto worker = [&results, &next]{
+    for (auto index = next.fetch_add(1); index < results.size(); index = next.fetch_add(1)) {
+      compileBatchFile(results[index]);
+    }
+  };
+  if (concurrency > 1) {
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < concurrency; ++thread) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  } else {
+    worker();
+  }
+  auto worst = egg::ovum::ILogger::Severity::None;
+  for (auto& result : results) {
+    worst = std::max(worst, result.severity);
+  }
+  return worst;
+}
+
+std::vector<std::string> egg::yolk::EggEngineFactory::findSourceFiles(const std::string& directory) {
+  // Sorted so that batch output does not depend on directory enumeration order
+  std::vector<std::string> found;
+  ::findSourceFiles(File::normalizePath(directory, false), found);
+  std::sort(found.begin(), found.end());
+  return found;
+}
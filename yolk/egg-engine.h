@@ -2,11 +2,15 @@ namespace egg::yolk {
   class IEggEnginePreparationContext : public egg::ovum::ILogger {
   public:
     virtual egg::ovum::IAllocator& allocator() const = 0;
-    };
+    // Threads preparing function bodies: one stays serial, zero picks automatically
+    // Values other than one share allocator() between threads, so it must then be thread-safe
+    virtual size_t concurrency() const = 0;
+  };
 
   class IEggEngineExecutionContext : public egg::ovum::ILogger {
   public:
     virtual egg::ovum::IAllocator& allocator() const = 0;
+    virtual size_t maxCallDepth() const = 0; // Nested user function calls beyond this raise an exception instead of exhausting the stack
   };
 
   class IEggEngineCompilationContext : public egg::ovum::ILogger {
@@ -22,12 +26,23 @@ namespace egg::yolk {
     virtual egg::ovum::ILogger::Severity compile(IEggEngineCompilationContext& compilation, egg::ovum::Module& out) = 0;
   };
 
+  struct EggEngineBatchResult {
+    std::string path;
+    egg::ovum::ILogger::Severity severity;
+    std::string diagnostics; // One logged message per line
+    std::string module; // Binary module image; empty on error
+  };
+
   class EggEngineFactory {
   public:
-    static std::shared_ptr<IEggEnginePreparationContext> createPreparationContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger);
-    static std::shared_ptr<IEggEngineExecutionContext> createExecutionContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger);
+    static std::shared_ptr<IEggEnginePreparationContext> createPreparationContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger, size_t concurrency = 1);
+    static std::shared_ptr<IEggEngineExecutionContext> createExecutionContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger, size_t maxCallDepth = egg::ovum::ProgramFactory::UnlimitedCallDepth);
     static std::shared_ptr<IEggEngineCompilationContext> createCompilationContext(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::ovum::ILogger>& logger);
     static std::shared_ptr<IEggEngine> createEngineFromParsed(egg::ovum::IAllocator& allocator, const egg::ovum::String& resource, const std::shared_ptr<IEggProgramNode>& root);
     static std::shared_ptr<IEggEngine> createEngineFromTextStream(TextStream& stream);
+
+    // Compile many files concurrently, each with its own allocator and logger; results are in input order
+    static egg::ovum::ILogger::Severity compileBatch(const std::vector<std::string>& paths, std::vector<EggEngineBatchResult>& results, size_t concurrency = 0);
+    static std::vector<std::string> findSourceFiles(const std::string& directory);
   };
 }
@@ -34,8 +34,9 @@ namespace {
     virtual egg::ovum::Variant getPositional(size_t index) const override {
       return this->positional.at(index).value;
     }
-    virtual const egg::ovum::LocationSource* getPositionalLocation(size_t index) const override {
-      return &this->positional.at(index).location;
+    virtual bool getPositionalLocation(size_t index, egg::ovum::LocationSource& location) const override {
+      location = this->positional.at(index).location;
+      return true;
     }
     virtual size_t getNamedCount() const override {
       return this->named.size();
@@ -48,8 +49,26 @@ namespace {
     virtual egg::ovum::Variant getNamed(const egg::ovum::String& name) const override {
       return this->named.at(name).value;
     }
-    virtual const egg::ovum::LocationSource* getNamedLocation(const egg::ovum::String& name) const override {
-      return &this->named.at(name).location;
+    virtual bool getNamedLocation(const egg::ovum::String& name, egg::ovum::LocationSource& location) const override {
+      location = this->named.at(name).location;
+      return true;
+    }
+  };
+
+  class CallFrame {
+    EGG_NO_COPY(CallFrame);
+  private:
+    egg::yolk::EggProgramContext::CallDepth* calls;
+  public:
+    explicit CallFrame(egg::yolk::EggProgramContext::CallDepth* calls) : calls(calls) {
+      if (calls != nullptr) {
+        calls->depth++;
+      }
+    }
+    ~CallFrame() {
+      if (this->calls != nullptr) {
+        this->calls->depth--;
+      }
     }
   };
 }
@@ -382,16 +401,17 @@ egg::ovum::Variant egg::yolk::EggProgramContext::executeFunctionCall(const egg::
     auto result = nested->addSymbol(EggProgramSymbol::ReadWrite, pname, ptype)->assign(*this, pvalue);
     if (result.hasFlowControl()) {
       // Re-create the exception with the parameter name included
-      auto* plocation = parameters.getPositionalLocation(i);
-      if (plocation != nullptr) {
-        // Update our current source location (it will be restored when executeFunctionCall returns)
-        egg::ovum::LocationSource& source = this->location;
-        source = *plocation;
-      }
+      // Update our current source location (it will be restored when executeFunctionCall returns)
+      egg::ovum::LocationSource& source = this->location;
+      (void)parameters.getPositionalLocation(i, source);
       return this->raiseFormat("Type mismatch for parameter '", pname, "': Expected '", ptype.toString(), "', but got '", pvalue.getRuntimeType().toString(), "' instead");
     }
   }
+  if ((this->calls != nullptr) && (this->calls->depth >= this->calls->maximum)) {
+    return this->raiseFormat("Maximum call depth of ", this->calls->maximum, " exceeded");
+  }
   auto context = this->createNestedContext(*nested);
+  CallFrame frame(this->calls);
   auto retval = block->execute(*context);
   if (retval.stripFlowControl(egg::ovum::VariantBits::Return)) {
     // Explicit return
@@ -756,6 +776,8 @@ egg::ovum::ILogger::Severity egg::yolk::EggProgram::execute(IEggEngineExecutionC
   symtable->addBuiltins();
   egg::ovum::ILogger::Severity severity = egg::ovum::ILogger::Severity::None;
   auto context = this->createRootContext(allocator, execution, *symtable, severity);
+  EggProgramContext::CallDepth calls{ 0, execution.maxCallDepth() };
+  context->setCallDepth(calls);
   auto retval = this->root->execute(*context);
   if (retval.stripFlowControl(egg::ovum::VariantBits::Throw)) {
     // TODO exception location
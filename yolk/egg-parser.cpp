@@ -13,11 +13,68 @@ namespace {
     return egg::ovum::Bits::set(lhs, rhs);
   }
 
+  class EggParserArena : public egg::ovum::IAllocator {
+    // Program nodes outlive the parser, so the arena counts its live allocations and destroys itself after the last one
+    EGG_NO_COPY(EggParserArena);
+  private:
+    egg::ovum::IAllocator& underlying;
+    egg::ovum::AllocatorArena arena;
+    egg::ovum::Atomic<int64_t> atomic;
+  public:
+    explicit EggParserArena(egg::ovum::IAllocator& underlying)
+      : underlying(underlying), arena(underlying), atomic(1) {
+    }
+    virtual void* allocate(size_t bytes, size_t alignment) override {
+      this->atomic.increment();
+      return this->arena.allocate(bytes, alignment);
+    }
+    virtual void deallocate(void*, size_t) override {
+      this->release();
+    }
+    virtual bool statistics(Statistics& out) const override {
+      return this->arena.statistics(out);
+    }
+    void release() {
+      if (this->atomic.decrement() <= 0) {
+        this->underlying.destroy(this);
+      }
+    }
+  };
+
+  template<typename T>
+  class EggParserArenaAllocator {
+    // Standard allocator adaptor so that each node and its control block form a single arena allocation
+  public:
+    using value_type = T;
+    egg::ovum::IAllocator* arena;
+    explicit EggParserArenaAllocator(egg::ovum::IAllocator& arena)
+      : arena(&arena) {
+    }
+    template<typename U>
+    EggParserArenaAllocator(const EggParserArenaAllocator<U>& other)
+      : arena(other.arena) {
+    }
+    T* allocate(size_t count) {
+      return static_cast<T*>(this->arena->allocate(sizeof(T) * count, alignof(T)));
+    }
+    void deallocate(T* allocated, size_t) {
+      this->arena->deallocate(allocated, alignof(T));
+    }
+    template<typename U>
+    bool operator==(const EggParserArenaAllocator<U>& other) const {
+      return this->arena == other.arena;
+    }
+    template<typename U>
+    bool operator!=(const EggParserArenaAllocator<U>& other) const {
+      return this->arena != other.arena;
+    }
+  };
+
   template<typename T, typename... ARGS>
   std::shared_ptr<T> makeParserNode(const IEggParserContext& context, const IEggSyntaxNode& node, ARGS&&... args) {
     // Fetch the syntax node's location and create a new 'T' based on it
     egg::ovum::LocationSource location(context.getResourceName(), node.location().begin.line, node.location().begin.column);
-    return std::make_shared<T>(context.allocator(), location, std::forward<ARGS>(args)...);
+    return std::allocate_shared<T>(EggParserArenaAllocator<T>(context.arena()), context.allocator(), location, std::forward<ARGS>(args)...);
   }
 
   template<typename T>
@@ -275,11 +332,7 @@ namespace {
       ParserDump(os, "declare").add(this->name).add(tname).add(this->init);
     }
     virtual egg::ovum::Node compile(EggProgramCompiler& compiler) const override {
-      if (this->init == nullptr) {
-        // No initializer
-        return compiler.statement(this->locationSource, egg::ovum::OPCODE_DECLARE, compiler.type(this->locationSource, this->type), compiler.identifier(this->locationSource, this->name));
-      }
-      return compiler.statement(this->locationSource, egg::ovum::OPCODE_DECLARE, compiler.type(this->locationSource, this->type), compiler.identifier(this->locationSource, this->name), *this->init);
+      return compiler.declare(this->locationSource, this->name, this->type, this->init.get());
     }
   };
 
@@ -1354,14 +1407,22 @@ namespace {
   class EggParserContext : public EggParserContextBase {
   private:
     egg::ovum::IAllocator* mallocator;
+    EggParserArena* marena;
     egg::ovum::String resource;
   public:
     EggParserContext(egg::ovum::IAllocator& allocator, const egg::ovum::String& resource, EggParserAllowed allowed = EggParserAllowed::None)
-      : EggParserContextBase(allowed), mallocator(&allocator), resource(resource) {
+      : EggParserContextBase(allowed), mallocator(&allocator), marena(allocator.create<EggParserArena>(0, allocator)), resource(resource) {
+    }
+    virtual ~EggParserContext() override {
+      // Program nodes hold their own counts on the arena so it outlives the last of them
+      this->marena->release();
     }
     virtual egg::ovum::IAllocator& allocator() const override {
       return *this->mallocator;
     }
+    virtual egg::ovum::IAllocator& arena() const override {
+      return *this->marena;
+    }
     virtual egg::ovum::String getResourceName() const override {
       return this->resource;
     }
@@ -1378,6 +1439,9 @@ namespace {
     virtual egg::ovum::IAllocator& allocator() const override {
       return this->parent->allocator();
     }
+    virtual egg::ovum::IAllocator& arena() const override {
+      return this->parent->arena();
+    }
     virtual egg::ovum::String getResourceName() const override {
       return this->parent->getResourceName();
     }
@@ -1398,6 +1462,9 @@ namespace {
     virtual egg::ovum::IAllocator& allocator() const override {
       return this->nested.allocator();
     }
+    virtual egg::ovum::IAllocator& arena() const override {
+      return this->nested.arena();
+    }
     virtual egg::ovum::String getResourceName() const override {
       return this->nested.getResourceName();
     }
@@ -1485,6 +1552,7 @@ namespace {
   class EggParserModule : public IEggParser {
   public:
     virtual std::shared_ptr<IEggProgramNode> parse(egg::ovum::IAllocator& allocator, IEggTokenizer& tokenizer) override {
+      // The syntax tree and its arena are discarded as soon as it has been promoted
       auto syntax = EggParserFactory::createModuleSyntaxParser(allocator);
       auto ast = syntax->parse(tokenizer);
       EggParserContext context(allocator, tokenizer.resource());
@@ -1495,6 +1563,7 @@ namespace {
   class EggParserExpression : public IEggParser {
   public:
     virtual std::shared_ptr<IEggProgramNode> parse(egg::ovum::IAllocator& allocator, IEggTokenizer& tokenizer) override {
+      // The syntax tree and its arena are discarded as soon as it has been promoted
       auto syntax = EggParserFactory::createExpressionSyntaxParser(allocator);
       auto ast = syntax->parse(tokenizer);
       EggParserContext context(allocator, tokenizer.resource());
@@ -1989,6 +2058,12 @@ egg::ovum::Type EggParserNode_Brackets::getType() const {
 }
 
 egg::ovum::Type EggParserNode_Dot::getType() const {
+  // Ask the left-hand side what type the property has, if it knows
+  egg::ovum::String error;
+  auto type = this->lhs->getType()->dotable(this->rhs, error);
+  if (type != nullptr) {
+    return type;
+  }
   return egg::ovum::Type::AnyQ; // TODO
 }
 
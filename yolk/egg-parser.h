@@ -74,6 +74,7 @@ namespace egg::yolk {
   public:
     virtual ~IEggParserContext() {}
     virtual egg::ovum::IAllocator& allocator() const = 0;
+    virtual egg::ovum::IAllocator& arena() const = 0; // Lives until the last program node allocated from it is destroyed
     virtual egg::ovum::String getResourceName() const = 0;
     virtual bool isAllowed(EggParserAllowed allowed) const = 0;
     virtual EggParserAllowed inheritAllowed(EggParserAllowed allow, EggParserAllowed inherit) const = 0;
@@ -6,6 +6,8 @@
 #include "yolk/egg-engine.h"
 #include "yolk/egg-program.h"
 
+#include <thread>
+
 namespace {
   using namespace egg::yolk;
 
@@ -31,6 +33,27 @@ namespace {
     }
     return prepared;
   }
+  class Unyieldable {
+    EGG_NO_COPY(Unyieldable);
+  private:
+    EggProgramContext::ScopeFunction* function;
+    const char* saved;
+  public:
+    // Generators cannot resume in the middle of these statements, so reject 'yield' within them while preparing
+    Unyieldable(EggProgramContext::ScopeFunction* function, const char* statement)
+      : function(function),
+        saved(nullptr) {
+      if (function != nullptr) {
+        this->saved = function->unyieldable;
+        function->unyieldable = statement;
+      }
+    }
+    ~Unyieldable() {
+      if (this->function != nullptr) {
+        this->function->unyieldable = this->saved;
+      }
+    }
+  };
   EggProgramNodeFlags checkBinary(EggProgramContext& context, const egg::ovum::LocationSource& where, EggProgramBinary op, egg::ovum::BasalBits lexp, IEggProgramNode& lhs, egg::ovum::BasalBits rexp, IEggProgramNode& rhs) {
     auto lflags = checkBinarySide(context, where, op, "left-hand side", lexp, lhs);
     if (abandoned(lflags)) {
@@ -44,6 +67,38 @@ namespace {
   }
 }
 
+class egg::yolk::EggProgramContext::Deferral {
+  EGG_NO_COPY(Deferral);
+public:
+  class Log : public egg::ovum::ILogger {
+  public:
+    struct Entry {
+      Source source;
+      Severity severity;
+      std::string message;
+    };
+    std::vector<Entry> entries;
+    virtual void log(Source source, Severity severity, const std::string& message) override {
+      this->entries.push_back({ source, severity, message });
+    }
+  };
+  struct Body {
+    egg::ovum::String name;
+    egg::ovum::Type rettype;
+    egg::ovum::HardPtr<EggProgramSymbolTable> symtable;
+    std::shared_ptr<IEggProgramNode> block;
+    size_t position; // Index into the module log at which our own diagnostics belong
+    Log log;
+    EggProgramNodeFlags flags;
+    std::exception_ptr exception;
+  };
+  Log module;
+  std::deque<Body> bodies;
+  Deferral() = default;
+  // Fewer bodies than this are prepared serially because starting threads would cost more than it saves
+  static constexpr size_t ConcurrentBodiesMinimum = 16;
+};
+
 egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareScope(const IEggProgramNode* node, std::function<EggProgramNodeFlags(EggProgramContext&)> action) {
   egg::ovum::String name;
   egg::ovum::Type type{ egg::ovum::Type::Void };
@@ -91,7 +146,84 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareModule(const
   if (this->findDuplicateSymbols(statements)) {
     return EggProgramNodeFlags::Abandon;
   }
-  return this->prepareStatements(statements);
+  // First pass: prepare the module-level statements, deferring the function bodies and buffering diagnostics
+  assert(this->scopeDeferral == nullptr);
+  Deferral deferral;
+  auto* logger = this->logger;
+  this->logger = &deferral.module;
+  this->scopeDeferral = &deferral;
+  EggProgramNodeFlags retval;
+  try {
+    retval = this->prepareStatements(statements);
+    this->logger = logger;
+    this->scopeDeferral = nullptr;
+  } catch (...) {
+    this->logger = logger;
+    this->scopeDeferral = nullptr;
+    throw;
+  }
+  // Second pass: the module symbol table is no longer modified, so the bodies can be prepared concurrently
+  auto prepareBody = [this](Deferral::Body& body, EggProgramSymbolTable& module, EggProgramSymbolTable& symtable) {
+    try {
+      auto severity = egg::ovum::ILogger::Severity::None;
+      auto context = this->getAllocator().make<EggProgramContext>(this->location, body.log, module, severity);
+      body.flags = context->prepareFunctionBody(body.name, body.rettype, symtable, *body.block);
+    } catch (...) {
+      body.exception = std::current_exception();
+    }
+  };
+  auto concurrency = (this->concurrency == 0) ? size_t(std::thread::hardware_concurrency()) : this->concurrency;
+  if (deferral.bodies.size() < Deferral::ConcurrentBodiesMinimum) {
+    concurrency = 1;
+  }
+  concurrency = std::min(concurrency, deferral.bodies.size());
+  if (concurrency > 1) {
+    std::atomic<size_t> next{ 0 };
+    auto worker = [this, &deferral, &next, &prepareBody]{
+      // Each worker has its own basket (and copies of the symbol tables) so that baskets are never shared between threads
+      auto& allocator = this->getAllocator();
+      auto basket = egg::ovum::BasketFactory::createBasket(allocator);
+      auto module = this->symtable->clone(*basket, nullptr);
+      for (auto index = next.fetch_add(1); index < deferral.bodies.size(); index = next.fetch_add(1)) {
+        auto& body = deferral.bodies[index];
+        prepareBody(body, *module, *body.symtable->clone(*basket, module.get()));
+      }
+      module = nullptr;
+      (void)basket->collect();
+    };
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < concurrency; ++thread) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  } else {
+    for (auto& body : deferral.bodies) {
+      prepareBody(body, *this->symtable, *body.symtable);
+    }
+  }
+  // Merge the diagnostics in the order a single pass would have produced them
+  auto replay = [this](const Deferral::Log& log, size_t begin, size_t end) {
+    for (auto index = begin; index < end; ++index) {
+      auto& entry = log.entries[index];
+      this->log(entry.source, entry.severity, entry.message);
+    }
+  };
+  size_t position = 0;
+  for (auto& body : deferral.bodies) {
+    replay(deferral.module, position, body.position);
+    position = body.position;
+    replay(body.log, 0, body.log.entries.size());
+    if (body.exception != nullptr) {
+      std::rethrow_exception(body.exception);
+    }
+    if (abandoned(body.flags)) {
+      return body.flags;
+    }
+  }
+  replay(deferral.module, position, deferral.module.entries.size());
+  return retval;
 }
 
 egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareBlock(const std::vector<std::shared_ptr<IEggProgramNode>>& statements) {
@@ -293,6 +425,7 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareFor(IEggProg
 }
 
 egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareForeach(IEggProgramNode& lvalue, IEggProgramNode& rvalue, IEggProgramNode& block) {
+  Unyieldable unyieldable(this->scopeFunction, "for-each");
   return this->prepareScope(&lvalue, [&](EggProgramContext& scope) {
     if (abandoned(rvalue.prepare(scope))) {
       return EggProgramNodeFlags::Abandon;
@@ -321,11 +454,27 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareFunctionDefi
     nested->addSymbol(EggProgramSymbol::ReadWrite, parameter.getName(), parameter.getType());
   }
   auto rettype = callable->getReturnType();
+  if (this->scopeDeferral != nullptr) {
+    // Defer preparation of the body until after the module; it may only see the symbols declared so far
+    nested->hideLaterParentSymbols();
+    auto& body = this->scopeDeferral->bodies.emplace_back();
+    body.name = name;
+    body.rettype = rettype;
+    body.symtable = nested;
+    body.block = block;
+    body.position = this->scopeDeferral->module.entries.size();
+    body.flags = EggProgramNodeFlags::None;
+    return EggProgramNodeFlags::Fallthrough;
+  }
+  return this->prepareFunctionBody(name, rettype, *nested, *block);
+}
+
+egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareFunctionBody(const egg::ovum::String& name, const egg::ovum::Type& rettype, EggProgramSymbolTable& symtable, IEggProgramNode& block) {
   // This structure will be overwritten later if this is actually a generator definition
-  ScopeFunction function = { rettype.get(), false };
-  auto context = this->createNestedContext(*nested, &function);
+  ScopeFunction function = { rettype.get(), false, nullptr };
+  auto context = this->createNestedContext(symtable, &function);
   assert(context->scopeFunction == &function);
-  auto flags = block->prepare(*context);
+  auto flags = block.prepare(*context);
   if (abandoned(flags)) {
     return flags;
   }
@@ -336,7 +485,7 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareFunctionDefi
       if (!name.empty()) {
         suffix = egg::ovum::StringBuilder::concat(": '", name, "'");
       }
-      return context->compilerError(block->location(), "Missing 'return' statement with a value of type '", egg::ovum::Type(function.rettype).toString(), "' at the end of the function definition", suffix);
+      return context->compilerError(block.location(), "Missing 'return' statement with a value of type '", egg::ovum::Type(function.rettype).toString(), "' at the end of the function definition", suffix);
     }
   }
   return EggProgramNodeFlags::Fallthrough; // We fallthrough AFTER the function definition
@@ -400,6 +549,7 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareCase(const s
 
 egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareSwitch(IEggProgramNode& value, int64_t defaultIndex, const std::vector<std::shared_ptr<IEggProgramNode>>& cases) {
   // TODO check duplicate constants
+  Unyieldable unyieldable(this->scopeFunction, "switch");
   return this->prepareScope(&value, [&](EggProgramContext& scope) {
     if (abandoned(value.prepare(scope))) {
       return EggProgramNodeFlags::Abandon;
@@ -426,6 +576,7 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareThrow(IEggPr
 
 egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareTry(IEggProgramNode& block, const std::vector<std::shared_ptr<IEggProgramNode>>& catches, IEggProgramNode* final) {
   // TODO
+  Unyieldable unyieldable(this->scopeFunction, "try");
   auto flags = block.prepare(*this);
   if (abandoned(flags)) {
     return EggProgramNodeFlags::Abandon;
@@ -458,6 +609,9 @@ egg::yolk::EggProgramNodeFlags egg::yolk::EggProgramContext::prepareYield(const
   if ((this->scopeFunction == nullptr) || !this->scopeFunction->generator) {
     return this->compilerError(where, "Unexpected 'yield' statement");
   }
+  if (this->scopeFunction->unyieldable != nullptr) {
+    return this->compilerError(where, "The 'yield' statement is not supported within '", this->scopeFunction->unyieldable, "' statements of generators");
+  }
   if (abandoned(value.prepare(*this))) {
     return EggProgramNodeFlags::Abandon;
   }
@@ -741,6 +895,7 @@ egg::ovum::ILogger::Severity egg::yolk::EggProgram::prepare(IEggEnginePreparatio
   symtable->addBuiltins();
   egg::ovum::ILogger::Severity severity = egg::ovum::ILogger::Severity::None;
   auto context = this->createRootContext(allocator, preparation, *symtable, severity);
+  context->setConcurrency(preparation.concurrency());
   if (abandoned(this->root->prepare(*context))) {
     return egg::ovum::ILogger::Severity::Error;
   }
@@ -318,7 +318,7 @@ void egg::yolk::EggProgramSymbolTable::addBuiltin(const std::string& name, const
 }
 
 std::shared_ptr<egg::yolk::EggProgramSymbol> egg::yolk::EggProgramSymbolTable::addSymbol(EggProgramSymbol::Kind kind, const egg::ovum::String& name, const egg::ovum::Type& type, const egg::ovum::Variant& value) {
-  auto result = this->map.emplace(name, std::make_shared<EggProgramSymbol>(kind, name, type, value));
+  auto result = this->map.emplace(name, std::make_shared<EggProgramSymbol>(kind, name, type, value, this->map.size()));
   assert(result.second);
   auto symbol = result.first->second;
   symbol->getValue().soften(*this->basket);
@@ -326,12 +326,34 @@ std::shared_ptr<egg::yolk::EggProgramSymbol> egg::yolk::EggProgramSymbolTable::a
 }
 
 std::shared_ptr<egg::yolk::EggProgramSymbol> egg::yolk::EggProgramSymbolTable::findSymbol(const egg::ovum::String& name, bool includeParents) const {
+  return this->findSymbolBefore(name, includeParents, SIZE_MAX);
+}
+
+void egg::yolk::EggProgramSymbolTable::hideLaterParentSymbols() {
+  // Symbols subsequently added to the parent will not be found via this table
+  assert(this->parent != nullptr);
+  this->visible = this->parent->map.size();
+}
+
+egg::ovum::HardPtr<egg::yolk::EggProgramSymbolTable> egg::yolk::EggProgramSymbolTable::clone(egg::ovum::IBasket& basket, EggProgramSymbolTable* parent) const {
+  // The symbols themselves are shared, so neither table may add to them whilst both are in use
+  auto table = this->allocator.make<EggProgramSymbolTable>(parent);
+  if (parent == nullptr) {
+    basket.take(*table);
+  }
+  assert(table->softGetBasket() == &basket);
+  table->map = this->map;
+  table->visible = this->visible;
+  return table;
+}
+
+std::shared_ptr<egg::yolk::EggProgramSymbol> egg::yolk::EggProgramSymbolTable::findSymbolBefore(const egg::ovum::String& name, bool includeParents, size_t ordinal) const {
   auto found = this->map.find(name);
-  if (found != this->map.end()) {
+  if ((found != this->map.end()) && (found->second->getOrdinal() < ordinal)) {
     return found->second;
   }
   if (includeParents && (this->parent != nullptr)) {
-    return this->parent->findSymbol(name);
+    return this->parent->findSymbolBefore(name, true, this->visible);
   }
   return nullptr;
 }
@@ -947,12 +969,12 @@ egg::ovum::Module egg::test::Compiler::compileText(egg::ovum::IAllocator& alloca
   return compileModule(allocator, logger, stream);
 }
 
-egg::ovum::Variant egg::test::Compiler::run(egg::ovum::IAllocator& allocator, egg::ovum::ILogger& logger, const std::string& path) {
+egg::ovum::Variant egg::test::Compiler::run(egg::ovum::IAllocator& allocator, egg::ovum::ILogger& logger, const std::string& path, size_t maxCallDepth) {
   auto module = egg::test::Compiler::compileFile(allocator, logger, path);
   if (module == nullptr) {
     return egg::ovum::Variant::Rethrow;
   }
-  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger);
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger, maxCallDepth);
   auto result = program->run(*module);
   if (result.hasThrow()) {
     auto thrown = result;
@@ -64,11 +64,13 @@ namespace egg::yolk {
     egg::ovum::String name;
     egg::ovum::Type type;
     egg::ovum::Variant value;
+    size_t ordinal; // Order of declaration within the owning symbol table
   public:
-    EggProgramSymbol(Kind kind, const egg::ovum::String& name, const egg::ovum::Type& type, const egg::ovum::Variant& value)
-      : kind(kind), name(name), type(type), value(value) {
+    EggProgramSymbol(Kind kind, const egg::ovum::String& name, const egg::ovum::Type& type, const egg::ovum::Variant& value, size_t ordinal)
+      : kind(kind), name(name), type(type), value(value), ordinal(ordinal) {
     }
     const egg::ovum::String& getName() const { return this->name; }
+    size_t getOrdinal() const { return this->ordinal; }
     const egg::ovum::IType& getType() const { return *this->type; }
     egg::ovum::Variant& getValue() { return this->value; }
     void setInferredType(const egg::ovum::Type& inferred);
@@ -80,9 +82,10 @@ namespace egg::yolk {
   private:
     std::map<egg::ovum::String, std::shared_ptr<EggProgramSymbol>> map;
     egg::ovum::SoftPtr<EggProgramSymbolTable> parent;
+    size_t visible; // Only parent symbols with lower ordinals are found via this table
   public:
     explicit EggProgramSymbolTable(egg::ovum::IAllocator& allocator, EggProgramSymbolTable* parent = nullptr)
-      : SoftReferenceCounted(allocator) {
+      : SoftReferenceCounted(allocator), visible(SIZE_MAX) {
       this->parent.set(*this, parent);
     }
     virtual void softVisitLinks(const Visitor& visitor) const override;
@@ -90,6 +93,10 @@ namespace egg::yolk {
     void addBuiltin(const std::string& name, const egg::ovum::Variant& value);
     std::shared_ptr<EggProgramSymbol> addSymbol(EggProgramSymbol::Kind kind, const egg::ovum::String& name, const egg::ovum::Type& type, const egg::ovum::Variant& value = egg::ovum::Variant::Void);
     std::shared_ptr<EggProgramSymbol> findSymbol(const egg::ovum::String& name, bool includeParents = true) const;
+    void hideLaterParentSymbols();
+    egg::ovum::HardPtr<EggProgramSymbolTable> clone(egg::ovum::IBasket& basket, EggProgramSymbolTable* parent) const;
+  private:
+    std::shared_ptr<EggProgramSymbol> findSymbolBefore(const egg::ovum::String& name, bool includeParents, size_t ordinal) const;
   };
 
   class EggProgram {
@@ -147,6 +154,11 @@ namespace egg::yolk {
     struct ScopeFunction {
       const egg::ovum::IType* rettype;
       bool generator;
+      const char* unyieldable; // The enclosing statement that cannot resume a 'yield', if any
+    };
+    struct CallDepth {
+      size_t depth;
+      size_t maximum;
     };
   private:
     egg::ovum::LocationRuntime location;
@@ -156,6 +168,10 @@ namespace egg::yolk {
     const egg::ovum::IType* scopeDeclare; // Only used in prepare phase
     ScopeFunction* scopeFunction; // Only used in prepare phase
     const egg::ovum::Variant* scopeValue; // Only used in execute phase
+    class Deferral;
+    Deferral* scopeDeferral; // Only used in prepare phase
+    size_t concurrency; // Only used in prepare phase: threads for deferred function bodies (zero for automatic)
+    CallDepth* calls; // Only used in execute phase: shared by every context of one execution (null for unlimited)
     EggProgramContext(egg::ovum::IAllocator& allocator, const egg::ovum::LocationRuntime& location, egg::ovum::ILogger* logger, EggProgramSymbolTable& symtable, egg::ovum::ILogger::Severity* maximumSeverity, ScopeFunction* scopeFunction)
       : SoftReferenceCounted(allocator),
         location(location),
@@ -163,17 +179,27 @@ namespace egg::yolk {
         maximumSeverity(maximumSeverity),
         scopeDeclare(nullptr),
         scopeFunction(scopeFunction),
-        scopeValue(nullptr) {
+        scopeValue(nullptr),
+        scopeDeferral(nullptr),
+        concurrency(1),
+        calls(nullptr) {
       this->symtable.set(*this, &symtable);
     }
   public:
     EggProgramContext(egg::ovum::IAllocator& allocator, EggProgramContext& parent, EggProgramSymbolTable& symtable, ScopeFunction* scopeFunction)
       : EggProgramContext(allocator, parent.location, parent.logger, symtable, parent.maximumSeverity, scopeFunction) {
+      this->calls = parent.calls;
     }
     EggProgramContext(egg::ovum::IAllocator& allocator, const egg::ovum::LocationRuntime& location, egg::ovum::ILogger& logger, EggProgramSymbolTable& symtable, egg::ovum::ILogger::Severity& maximumSeverity)
       : EggProgramContext(allocator, location, &logger, symtable, &maximumSeverity, nullptr) {
     }
     virtual void softVisitLinks(const Visitor& visitor) const override;
+    void setConcurrency(size_t threads) {
+      this->concurrency = threads;
+    }
+    void setCallDepth(CallDepth& budget) {
+      this->calls = &budget;
+    }
     egg::ovum::HardPtr<EggProgramContext> createNestedContext(EggProgramSymbolTable& symtable, ScopeFunction* prepareFunction = nullptr);
     void log(egg::ovum::ILogger::Source source, egg::ovum::ILogger::Severity severity, const std::string& message);
     template<typename... ARGS>
@@ -306,6 +332,7 @@ namespace egg::yolk {
     bool findDuplicateSymbols(const std::vector<std::shared_ptr<IEggProgramNode>>& statements);
     EggProgramNodeFlags prepareScope(const IEggProgramNode* node, std::function<EggProgramNodeFlags(EggProgramContext&)> action);
     EggProgramNodeFlags prepareStatements(const std::vector<std::shared_ptr<IEggProgramNode>>& statements);
+    EggProgramNodeFlags prepareFunctionBody(const egg::ovum::String& name, const egg::ovum::Type& rettype, EggProgramSymbolTable& symtable, IEggProgramNode& block);
     EggProgramNodeFlags typeCheck(const egg::ovum::LocationSource& where, egg::ovum::Type& ltype, const egg::ovum::Type& rtype, const egg::ovum::String& name, bool guard);
     typedef std::function<egg::ovum::Variant(EggProgramContext&)> ScopeAction;
     egg::ovum::Variant executeScope(const IEggProgramNode* node, ScopeAction action);
@@ -334,10 +361,11 @@ namespace egg::yolk {
     egg::ovum::NodeLocation location;
     egg::ovum::Opcode opcode;
     egg::ovum::Nodes nodes;
+    egg::ovum::Nodes attributes;
     bool failed;
   public:
     EggProgramCompilerNode(EggProgramCompiler& compiler, const egg::ovum::LocationSource& location, egg::ovum::Opcode opcode)
-      : compiler(compiler), opcode(opcode), nodes(), failed(false) {
+      : compiler(compiler), opcode(opcode), nodes(), attributes(), failed(false) {
       this->location.line = location.line;
       this->location.column = location.column;
     }
@@ -349,6 +377,7 @@ namespace egg::yolk {
     EggProgramCompilerNode& add(const T& value, ARGS&&... args) {
       return this->add(value).add(std::forward<ARGS>(args)...);
     }
+    EggProgramCompilerNode& attribute(const egg::ovum::String& key, egg::ovum::Node&& value);
     egg::ovum::Node build();
     egg::ovum::Node build(egg::ovum::Operator operand);
   };
@@ -372,6 +401,8 @@ namespace egg::yolk {
     egg::ovum::Node ternary(const egg::ovum::LocationSource& location, EggProgramTernary op, const IEggProgramNode& a, const IEggProgramNode& b, const IEggProgramNode& c);
     egg::ovum::Node mutate(const egg::ovum::LocationSource& location, EggProgramMutate op, const IEggProgramNode& a);
     egg::ovum::Node assign(const egg::ovum::LocationSource& location, EggProgramAssign op, const IEggProgramNode& a, const IEggProgramNode& b);
+    egg::ovum::Node assignment(const egg::ovum::LocationSource& location, const IEggProgramNode& a, const IEggProgramNode& b);
+    egg::ovum::Node declare(const egg::ovum::LocationSource& location, const egg::ovum::String& name, const egg::ovum::Type& vtype, const IEggProgramNode* init);
     egg::ovum::Node predicate(const egg::ovum::LocationSource& location, EggProgramBinary op, const IEggProgramNode& a, const IEggProgramNode& b);
     egg::ovum::Node noop(const egg::ovum::LocationSource& location, const IEggProgramNode* node);
     template<typename... ARGS>
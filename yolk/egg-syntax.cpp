@@ -436,28 +436,17 @@ bool egg::yolk::EggSyntaxNode_Literal::negate() {
 #define EGG_TOKENIZER_OPERATOR_EXPECTATION(key, text) \
   "Expected expression after infix '" text "' operator",
 
-#define PARSE_BINARY_LTR(parent, child, condition) \
-  std::unique_ptr<IEggSyntaxNode> parent(const char* expected) { \
-    EggSyntaxParserBacktrackMark mark(this->backtrack); \
-    auto expr = this->child(expected); \
-    for (auto* token = &mark.peek(0); (expr != nullptr) && (condition); token = &mark.peek(0)) { \
-      mark.advance(1); \
-      auto lhs = std::move(expr); \
-      auto rhs = this->child(getInfixOperatorExpectation(token->value.o)); \
-      EggSyntaxNodeLocation location(*token); \
-      expr = std::make_unique<EggSyntaxNode_BinaryOperator>(location, token->value.o, std::move(lhs), std::move(rhs)); \
-    } \
-    mark.accept(0); \
-    return expr; \
-  }
-#define PARSE_BINARY1_LTR(parent, child, op) \
-  PARSE_BINARY_LTR(parent, child, token->isOperator(op))
-#define PARSE_BINARY2_LTR(parent, child, op1, op2) \
-  PARSE_BINARY_LTR(parent, child, token->isOperator(op1) || token->isOperator(op2))
-#define PARSE_BINARY3_LTR(parent, child, op1, op2, op3) \
-  PARSE_BINARY_LTR(parent, child, token->isOperator(op1) || token->isOperator(op2) || token->isOperator(op3))
-#define PARSE_BINARY4_LTR(parent, child, op1, op2, op3, op4) \
-  PARSE_BINARY_LTR(parent, child, token->isOperator(op1) || token->isOperator(op2) || token->isOperator(op3) || token->isOperator(op4))
+void* egg::yolk::EggSyntaxNodeBase::operator new(size_t bytes, egg::ovum::IAllocator& arena) {
+  return arena.allocate(bytes, alignof(std::max_align_t));
+}
+
+void egg::yolk::EggSyntaxNodeBase::operator delete(void*, egg::ovum::IAllocator&) {
+  // Only called if a constructor throws: the arena reclaims the memory
+}
+
+void egg::yolk::EggSyntaxNodeBase::operator delete(void*) {
+  // The arena reclaims the memory when the whole tree is released
+}
 
 namespace {
   using namespace egg::yolk;
@@ -471,6 +460,87 @@ namespace {
     return table[i];
   }
 
+  enum class Precedence {
+    None,
+    NullCoalescing,
+    LogicalOr,
+    LogicalAnd,
+    InclusiveOr,
+    ExclusiveOr,
+    And,
+    Equality,
+    Relational,
+    Shift,
+    Additive,
+    Multiplicative,
+    Unary // binds more tightly than any infix operator
+  };
+
+  Precedence getInfixOperatorPrecedence(const EggTokenizerItem& item) {
+    // All infix operators are left-associative
+    if (item.kind == EggTokenizerKind::Operator) {
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (item.value.o) {
+      case EggTokenizerOperator::QueryQuery:
+        return Precedence::NullCoalescing;
+      case EggTokenizerOperator::BarBar:
+        return Precedence::LogicalOr;
+      case EggTokenizerOperator::AmpersandAmpersand:
+        return Precedence::LogicalAnd;
+      case EggTokenizerOperator::Bar:
+        return Precedence::InclusiveOr;
+      case EggTokenizerOperator::Caret:
+        return Precedence::ExclusiveOr;
+      case EggTokenizerOperator::Ampersand:
+        return Precedence::And;
+      case EggTokenizerOperator::EqualEqual:
+      case EggTokenizerOperator::BangEqual:
+        return Precedence::Equality;
+      case EggTokenizerOperator::Less:
+      case EggTokenizerOperator::LessEqual:
+      case EggTokenizerOperator::Greater:
+      case EggTokenizerOperator::GreaterEqual:
+        return Precedence::Relational;
+      case EggTokenizerOperator::ShiftLeft:
+      case EggTokenizerOperator::ShiftRight:
+      case EggTokenizerOperator::ShiftRightUnsigned:
+        return Precedence::Shift;
+      case EggTokenizerOperator::Plus:
+      case EggTokenizerOperator::Minus:
+      case EggTokenizerOperator::PlusPlus:
+      case EggTokenizerOperator::MinusMinus:
+        return Precedence::Additive;
+      case EggTokenizerOperator::Star:
+      case EggTokenizerOperator::Slash:
+      case EggTokenizerOperator::Percent:
+        return Precedence::Multiplicative;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+    }
+    return Precedence::None;
+  }
+
+  Precedence getTighterPrecedence(Precedence precedence) {
+    assert(precedence < Precedence::Unary);
+    return Precedence(int(precedence) + 1);
+  }
+
+  bool startsType(const EggTokenizerItem& p0, const EggTokenizerItem& p1) {
+    // Decide with two tokens of lookahead whether a type (rather than an expression) starts here
+    if (p0.isKeyword(EggTokenizerKeyword::Var) || p0.isKeyword(EggTokenizerKeyword::Void) || p0.isKeyword(EggTokenizerKeyword::Any)) {
+      return true;
+    }
+    if (p0.isKeyword(EggTokenizerKeyword::Null)) {
+      // This is the 'null' literal in expressions
+      return false;
+    }
+    if (keywordToBasal(p0) != egg::ovum::BasalBits::None) {
+      // It could be a constructor like 'string(...)' or a property like 'float.epsilon'
+      return !p1.isOperator(EggTokenizerOperator::ParenthesisLeft) && !p1.isOperator(EggTokenizerOperator::Dot);
+    }
+    return false;
+  }
+
   class EggSyntaxParserLookahead {
   private:
     IEggTokenizer* tokenizer;
@@ -527,97 +597,83 @@ namespace {
     }
   };
 
-  class EggSyntaxParserBacktrack {
-    friend class EggSyntaxParserBacktrackMark;
+  class EggSyntaxParserCursor {
+    // The parser is predictive: tokens are only ever consumed, never rewound
   private:
     EggSyntaxParserLookahead lookahead;
-    size_t cursor;
+    size_t offset;
   public:
-    explicit EggSyntaxParserBacktrack(IEggTokenizer& tokenizer)
-      : lookahead(tokenizer), cursor(0) {
+    explicit EggSyntaxParserCursor(IEggTokenizer& tokenizer)
+      : lookahead(tokenizer), offset(0) {
     }
     const EggTokenizerItem& peek(size_t index) {
-      return this->lookahead.peek(this->cursor + index);
+      return this->lookahead.peek(this->offset + index);
     }
-    size_t advance(size_t count) {
-      // Called by EggSyntaxParserBacktrackMark advance
-      this->cursor += count;
-      return this->cursor;
+    void advance(size_t count) {
+      this->offset += count;
     }
     void commit() {
-      if (this->cursor > 0) {
-        this->lookahead.pop(this->cursor);
-        this->cursor = 0;
+      // Release the tokens consumed by a complete statement
+      if (this->offset > 0) {
+        this->lookahead.pop(this->offset);
+        this->offset = 0;
       }
     }
     egg::ovum::String resource() const {
       return this->lookahead.resource();
     }
-  private:
-    size_t mark() {
-      // Called by EggSyntaxParserBacktrackMark ctor
-      return this->cursor;
-    }
-    void abandon(size_t previous) {
-      // Called by EggSyntaxParserBacktrackMark dtor
-      this->cursor = previous;
-    }
   };
 
-  class EggSyntaxParserBacktrackMark {
-  private:
-    EggSyntaxParserBacktrack* backtrack;
-    size_t previous;
-  public:
-    explicit EggSyntaxParserBacktrackMark(EggSyntaxParserBacktrack& backtrack)
-      : backtrack(&backtrack), previous(backtrack.mark()) {
-    }
-    ~EggSyntaxParserBacktrackMark() {
-      this->backtrack->abandon(this->previous);
+  struct EggSyntaxTree {
+    // Syntax nodes are bump-allocated from the tree's arena; types still come from the parser's allocator as they outlive the tree
+    egg::ovum::AllocatorArena arena;
+    std::unique_ptr<IEggSyntaxNode> root;
+    explicit EggSyntaxTree(egg::ovum::IAllocator& allocator)
+      : arena(allocator) {
     }
-    const EggTokenizerItem& peek(size_t index) {
-      return this->backtrack->peek(index);
-    }
-    void advance(size_t count) {
-      this->backtrack->advance(count);
-    }
-    void accept(size_t count) {
-      this->previous = this->backtrack->advance(count);
+    static std::shared_ptr<IEggSyntaxNode> share(const std::shared_ptr<EggSyntaxTree>& tree) {
+      // The returned root keeps the whole tree, and therefore the arena, alive
+      assert(tree->root != nullptr);
+      return std::shared_ptr<IEggSyntaxNode>(tree, tree->root.get());
     }
   };
 
   class EggSyntaxParserContext {
   private:
     egg::ovum::IAllocator* allocator;
-    EggSyntaxParserBacktrack backtrack;
+    egg::ovum::IAllocator* arena;
+    EggSyntaxParserCursor cursor;
   public:
-    EggSyntaxParserContext(egg::ovum::IAllocator& allocator, IEggTokenizer& tokenizer)
-      : allocator(&allocator), backtrack(tokenizer) {
+    EggSyntaxParserContext(egg::ovum::IAllocator& allocator, egg::ovum::IAllocator& arena, IEggTokenizer& tokenizer)
+      : allocator(&allocator), arena(&arena), cursor(tokenizer) {
+    }
+    template<typename T, typename... ARGS>
+    std::unique_ptr<T> make(ARGS&&... args) {
+      return std::unique_ptr<T>(new(*this->arena) T(std::forward<ARGS>(args)...));
+    }
+    bool isTypeStart() {
+      // Parenthesized types like '(void|int)' are decided by what follows the parentheses
+      size_t index = 0;
+      while (this->cursor.peek(index).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
+        index++;
+      }
+      return startsType(this->cursor.peek(index), this->cursor.peek(index + 1));
     }
     EGG_NORETURN void unexpected(const std::string& message) {
-      auto& item = this->backtrack.peek(0);
-      throw SyntaxException(message, this->backtrack.resource().toUTF8(), item);
+      auto& item = this->cursor.peek(0);
+      throw SyntaxException(message, this->cursor.resource().toUTF8(), item);
     }
     EGG_NORETURN void unexpected(const std::string& expected, const EggTokenizerItem& item) {
       auto token = item.toString();
-      throw SyntaxException(expected + ", not " + token, this->backtrack.resource().toUTF8(), item, token);
+      throw SyntaxException(expected + ", not " + token, this->cursor.resource().toUTF8(), item, token);
     }
     void parseEndOfFile(const char* expected);
     std::unique_ptr<IEggSyntaxNode> parseCompoundStatement();
     std::unique_ptr<IEggSyntaxNode> parseCondition(const char* expected);
     std::unique_ptr<IEggSyntaxNode> parseExpression(const char* expected);
     std::unique_ptr<IEggSyntaxNode> parseExpressionTernary(const char* expected);
-    PARSE_BINARY1_LTR(parseExpressionNullCoalescing, parseExpressionLogicalOr, EggTokenizerOperator::QueryQuery)
-    PARSE_BINARY1_LTR(parseExpressionLogicalOr, parseExpressionLogicalAnd, EggTokenizerOperator::BarBar)
-    PARSE_BINARY1_LTR(parseExpressionLogicalAnd, parseExpressionInclusiveOr, EggTokenizerOperator::AmpersandAmpersand)
-    PARSE_BINARY1_LTR(parseExpressionInclusiveOr, parseExpressionExclusiveOr, EggTokenizerOperator::Bar)
-    PARSE_BINARY1_LTR(parseExpressionExclusiveOr, parseExpressionAnd, EggTokenizerOperator::Caret)
-    PARSE_BINARY1_LTR(parseExpressionAnd, parseExpressionEquality, EggTokenizerOperator::Ampersand)
-    PARSE_BINARY2_LTR(parseExpressionEquality, parseExpressionRelational, EggTokenizerOperator::EqualEqual, EggTokenizerOperator::BangEqual)
-    PARSE_BINARY4_LTR(parseExpressionRelational, parseExpressionShift, EggTokenizerOperator::Less, EggTokenizerOperator::LessEqual, EggTokenizerOperator::Greater, EggTokenizerOperator::GreaterEqual)
-    PARSE_BINARY3_LTR(parseExpressionShift, parseExpressionAdditive, EggTokenizerOperator::ShiftLeft, EggTokenizerOperator::ShiftRight, EggTokenizerOperator::ShiftRightUnsigned)
-    PARSE_BINARY3_LTR(parseExpressionMultiplicative, parseExpressionUnary, EggTokenizerOperator::Star, EggTokenizerOperator::Slash, EggTokenizerOperator::Percent)
-    std::unique_ptr<IEggSyntaxNode> parseExpressionAdditive(const char* expected);
+    std::unique_ptr<IEggSyntaxNode> parseExpressionBinary(const char* expected, Precedence minimum);
+    std::unique_ptr<IEggSyntaxNode> parseExpressionInfix(std::unique_ptr<IEggSyntaxNode>&& lhs, Precedence minimum);
     std::unique_ptr<IEggSyntaxNode> parseExpressionNegative(const EggSyntaxNodeLocation& location);
     std::unique_ptr<IEggSyntaxNode> parseExpressionUnary(const char* expected);
     std::unique_ptr<IEggSyntaxNode> parseExpressionPostfix(const char* expected);
@@ -641,6 +697,7 @@ namespace {
     std::unique_ptr<IEggSyntaxNode> parseStatementExpression(std::unique_ptr<IEggSyntaxNode>&& expr, EggTokenizerOperator terminal);
     std::unique_ptr<IEggSyntaxNode> parseStatementFor();
     std::unique_ptr<IEggSyntaxNode> parseStatementForeach();
+    bool isStatementForeach();
     std::unique_ptr<IEggSyntaxNode> parseStatementFunction(std::unique_ptr<IEggSyntaxNode>&& type, bool generator);
     std::unique_ptr<IEggSyntaxNode> parseStatementIf();
     std::unique_ptr<IEggSyntaxNode> parseStatementReturn();
@@ -664,8 +721,10 @@ namespace {
     explicit EggSyntaxParserModule(egg::ovum::IAllocator& allocator) : allocator(&allocator) {
     }
     virtual std::shared_ptr<IEggSyntaxNode> parse(IEggTokenizer& tokenizer) override {
-      EggSyntaxParserContext context(*this->allocator, tokenizer);
-      return context.parseModule();
+      auto tree = std::make_shared<EggSyntaxTree>(*this->allocator);
+      EggSyntaxParserContext context(*this->allocator, tree->arena, tokenizer);
+      tree->root = context.parseModule();
+      return EggSyntaxTree::share(tree);
     }
   };
 
@@ -676,11 +735,11 @@ namespace {
     explicit EggSyntaxParserStatement(egg::ovum::IAllocator& allocator) : allocator(&allocator) {
     }
     virtual std::shared_ptr<IEggSyntaxNode> parse(IEggTokenizer& tokenizer) override {
-      EggSyntaxParserContext context(*this->allocator, tokenizer);
-      auto result = context.parseStatement();
-      assert(result != nullptr);
+      auto tree = std::make_shared<EggSyntaxTree>(*this->allocator);
+      EggSyntaxParserContext context(*this->allocator, tree->arena, tokenizer);
+      tree->root = context.parseStatement();
       context.parseEndOfFile("Expected end of input after statement");
-      return result;
+      return EggSyntaxTree::share(tree);
     }
   };
 
@@ -691,17 +750,17 @@ namespace {
     explicit EggSyntaxParserExpression(egg::ovum::IAllocator& allocator) : allocator(&allocator) {
     }
     virtual std::shared_ptr<IEggSyntaxNode> parse(IEggTokenizer& tokenizer) override {
-      EggSyntaxParserContext context(*this->allocator, tokenizer);
-      auto result = context.parseExpression("Expression expected");
-      assert(result != nullptr);
+      auto tree = std::make_shared<EggSyntaxTree>(*this->allocator);
+      EggSyntaxParserContext context(*this->allocator, tree->arena, tokenizer);
+      tree->root = context.parseExpression("Expression expected");
       context.parseEndOfFile("Expected end of input after expression");
-      return result;
+      return EggSyntaxTree::share(tree);
     }
   };
 }
 
 void EggSyntaxParserContext::parseEndOfFile(const char* expected) {
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   if (p0.kind != EggTokenizerKind::EndOfFile) {
     this->unexpected(expected, p0);
   }
@@ -711,13 +770,13 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseModule() {
   /*
       module ::= statement+
   */
-  EggSyntaxNodeLocation location(this->backtrack.peek(0));
-  auto module = std::make_unique<EggSyntaxNode_Module>(location);
-  while (this->backtrack.peek(0).kind != EggTokenizerKind::EndOfFile) {
+  EggSyntaxNodeLocation location(this->cursor.peek(0));
+  auto module = this->make<EggSyntaxNode_Module>(location);
+  while (this->cursor.peek(0).kind != EggTokenizerKind::EndOfFile) {
     module->addChild(std::move(this->parseStatement()));
-    this->backtrack.commit();
+    this->cursor.commit();
   }
-  module->setLocationEnd(this->backtrack.peek(0), 0);
+  module->setLocationEnd(this->cursor.peek(0), 0);
   return module;
 }
 
@@ -733,7 +792,7 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatement() {
                          | assignment-statement
                          | void-function-call
   */
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   switch (p0.kind) {
   case EggTokenizerKind::Integer:
   case EggTokenizerKind::Float:
@@ -817,9 +876,11 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatement() {
   default:
     this->unexpected("Internal egg parser error (statement kind)");
   }
-  auto expression = this->parseExpression(nullptr);
-  if (expression != nullptr) {
-    return this->parseStatementExpression(std::move(expression), EggTokenizerOperator::Semicolon);
+  if (!this->isTypeStart()) {
+    auto expression = this->parseExpression(nullptr);
+    if (expression != nullptr) {
+      return this->parseStatementExpression(std::move(expression), EggTokenizerOperator::Semicolon);
+    }
   }
   auto type = this->parseType(nullptr);
   if (type == nullptr) {
@@ -836,16 +897,18 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementSimple(con
                          | void-function-call
   */
   assert(expected != nullptr);
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   if (p0.isOperator(EggTokenizerOperator::MinusMinus)) {
     return this->parseStatementDecrementIncrement(EggTokenizerOperator::MinusMinus, "decrement", "Expected expression after decrement '--' operator", terminal);
   }
   if (p0.isOperator(EggTokenizerOperator::PlusPlus)) {
     return this->parseStatementDecrementIncrement(EggTokenizerOperator::PlusPlus, "increment", "Expected expression after increment '++' operator", terminal);
   }
-  auto expression = this->parseExpression(nullptr);
-  if (expression != nullptr) {
-    return this->parseStatementExpression(std::move(expression), terminal);
+  if (!this->isTypeStart()) {
+    auto expression = this->parseExpression(nullptr);
+    if (expression != nullptr) {
+      return this->parseStatementExpression(std::move(expression), terminal);
+    }
   }
   if (terminal != EggTokenizerOperator::Semicolon) {
     // Only look for type statements if we end with a semicolon
@@ -863,17 +926,17 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseCompoundStatement()
       compound-statement ::= '{' statement* '}'
   */
   // cppcheck-suppress assertWithSideEffect
-  assert(this->backtrack.peek(0).isOperator(EggTokenizerOperator::CurlyLeft));
-  EggSyntaxNodeLocation location(this->backtrack.peek(0), 0);
-  this->backtrack.advance(1); // skip '{'
-  auto block = std::make_unique<EggSyntaxNode_Block>(location);
-  while (!this->backtrack.peek(0).isOperator(EggTokenizerOperator::CurlyRight)) {
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft));
+  EggSyntaxNodeLocation location(this->cursor.peek(0), 0);
+  this->cursor.advance(1); // skip '{'
+  auto block = this->make<EggSyntaxNode_Block>(location);
+  while (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyRight)) {
     block->addChild(std::move(this->parseStatement()));
-    this->backtrack.commit();
+    this->cursor.commit();
   }
-  block->setLocationEnd(this->backtrack.peek(0), 1);
-  this->backtrack.advance(1); // skip '}'
-  this->backtrack.commit();
+  block->setLocationEnd(this->cursor.peek(0), 1);
+  this->cursor.advance(1); // skip '}'
+  this->cursor.commit();
   return block;
 }
 
@@ -889,67 +952,73 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionTernary(c
       conditional-expression ::= null-coalescing-expression
                                | null-coalescing-expression '?' expression ':' conditional-expression
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto expr = this->parseExpressionNullCoalescing(expected);
+  auto expr = this->parseExpressionBinary(expected, Precedence::NullCoalescing);
   if (expr) {
-    if (mark.peek(0).isOperator(EggTokenizerOperator::Query)) {
+    if (this->cursor.peek(0).isOperator(EggTokenizerOperator::Query)) {
       // Expect <expression> ? <expression> : <conditional-expression>
-      EggSyntaxNodeLocation location(mark.peek(0), 0);
-      mark.advance(1);
+      EggSyntaxNodeLocation location(this->cursor.peek(0), 0);
+      this->cursor.advance(1);
       auto exprTrue = this->parseExpression("Expected expression after '?' of ternary '?:' operator");
-      if (!mark.peek(0).isOperator(EggTokenizerOperator::Colon)) {
-        this->unexpected("Expected ':' as part of ternary '?:' operator", mark.peek(0));
+      if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::Colon)) {
+        this->unexpected("Expected ':' as part of ternary '?:' operator", this->cursor.peek(0));
       }
-      location.setLocationEnd(mark.peek(0), 1);
-      mark.advance(1);
+      location.setLocationEnd(this->cursor.peek(0), 1);
+      this->cursor.advance(1);
       auto exprFalse = this->parseExpression("Expected expression after ':' of ternary '?:' operator");
-      mark.accept(0);
-      return std::make_unique<EggSyntaxNode_TernaryOperator>(location, std::move(expr), std::move(exprTrue), std::move(exprFalse));
+      return this->make<EggSyntaxNode_TernaryOperator>(location, std::move(expr), std::move(exprTrue), std::move(exprFalse));
     }
-    mark.accept(0);
   }
   return expr;
 }
 
-std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionAdditive(const char* expected) {
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto expr = this->parseExpressionMultiplicative(expected);
-  for (auto* token = &mark.peek(0); (expr != nullptr); token = &mark.peek(0)) {
-    EggSyntaxNodeLocation location(*token, 1);
-    if (token->isOperator(EggTokenizerOperator::Plus)) {
-      expected = "Expected expression after infix '+' operator";
-    } else if (token->isOperator(EggTokenizerOperator::Minus)) {
-      expected = "Expected expression after infix '-' operator";
-    } else if (token->isOperator(EggTokenizerOperator::PlusPlus)) {
+std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionBinary(const char* expected, Precedence minimum) {
+  /*
+      binary-expression ::= unary-expression
+                          | binary-expression infix-operator binary-expression
+  */
+  auto expr = this->parseExpressionUnary(expected);
+  return (expr == nullptr) ? nullptr : this->parseExpressionInfix(std::move(expr), minimum);
+}
+
+std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionInfix(std::unique_ptr<IEggSyntaxNode>&& lhs, Precedence minimum) {
+  // Precedence climbing: the right-hand operand only absorbs operators that bind more tightly
+  assert(minimum != Precedence::None);
+  auto expr = std::move(lhs);
+  for (;;) {
+    auto& token = this->cursor.peek(0);
+    auto precedence = getInfixOperatorPrecedence(token);
+    if ((precedence == Precedence::None) || (precedence < minimum)) {
+      break;
+    }
+    auto op = token.value.o;
+    if (op == EggTokenizerOperator::PlusPlus) {
       // We don't handle the special case of 'a++b' or 'a++1' because we have no unary plus operator
       this->unexpected("Unexpected '+' after infix '+' operator");
-    } else if (token->isOperator(EggTokenizerOperator::MinusMinus)) {
+    }
+    EggSyntaxNodeLocation location(token, 1);
+    this->cursor.advance(1);
+    std::unique_ptr<IEggSyntaxNode> rhs;
+    if (op == EggTokenizerOperator::MinusMinus) {
       // Handle the special case of 'a--b' or 'a--1'
-      mark.advance(1);
-      auto lhs = std::move(expr);
-      auto rhs = this->parseExpressionNegative(location);
-      expr = std::make_unique<EggSyntaxNode_BinaryOperator>(location, EggTokenizerOperator::Minus, std::move(lhs), std::move(rhs));
-      continue;
+      rhs = this->parseExpressionInfix(this->parseExpressionNegative(location), getTighterPrecedence(precedence));
+      op = EggTokenizerOperator::Minus;
     } else {
-      break;
+      location = EggSyntaxNodeLocation(token);
+      rhs = this->parseExpressionBinary(getInfixOperatorExpectation(op), getTighterPrecedence(precedence));
     }
-    mark.advance(1);
-    auto lhs = std::move(expr);
-    auto rhs = this->parseExpressionMultiplicative(expected);
-    expr = std::make_unique<EggSyntaxNode_BinaryOperator>(location, token->value.o, std::move(lhs), std::move(rhs));
+    expr = this->make<EggSyntaxNode_BinaryOperator>(location, op, std::move(expr), std::move(rhs));
   }
-  mark.accept(0);
   return expr;
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionNegative(const EggSyntaxNodeLocation& location) {
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   auto expr = this->parseExpressionUnary("Expected expression after prefix '-' operator");
   if (p0.contiguous && expr->negate()) {
     // Successfully negated the literal
     return expr;
   }
-  return std::make_unique<EggSyntaxNode_UnaryOperator>(location, EggTokenizerOperator::Minus, std::move(expr));
+  return this->make<EggSyntaxNode_UnaryOperator>(location, EggTokenizerOperator::Minus, std::move(expr));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionUnary(const char* expected) {
@@ -963,20 +1032,20 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionUnary(con
                        | '~'
                        | '!'
 */
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   if (p0.isOperator(EggTokenizerOperator::Ampersand)) {
     expected = "Expected expression after prefix '&' operator";
   } else if (p0.isOperator(EggTokenizerOperator::Star)) {
     expected = "Expected expression after prefix '*' operator";
   } else if (p0.isOperator(EggTokenizerOperator::Minus)) {
-    this->backtrack.advance(1);
+    this->cursor.advance(1);
     EggSyntaxNodeLocation location(p0, 1);
     return this->parseExpressionNegative(location);
   } else if (p0.isOperator(EggTokenizerOperator::MinusMinus)) {
-    this->backtrack.advance(1);
+    this->cursor.advance(1);
     EggSyntaxNodeLocation location(p0, 1);
     auto negative = this->parseExpressionNegative(location);
-    return std::make_unique<EggSyntaxNode_UnaryOperator>(location, EggTokenizerOperator::Minus, std::move(negative));
+    return this->make<EggSyntaxNode_UnaryOperator>(location, EggTokenizerOperator::Minus, std::move(negative));
   } else if (p0.isOperator(EggTokenizerOperator::Tilde)) {
     expected = "Expected expression after prefix '~' operator";
   } else if (p0.isOperator(EggTokenizerOperator::Bang)) {
@@ -984,12 +1053,10 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionUnary(con
   } else {
     return this->parseExpressionPostfix(expected);
   }
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   EggSyntaxNodeLocation location(p0, 1);
-  mark.advance(1);
+  this->cursor.advance(1);
   auto expr = this->parseExpressionUnary(expected);
-  mark.accept(0);
-  return std::make_unique<EggSyntaxNode_UnaryOperator>(location, p0.value.o, std::move(expr));
+  return this->make<EggSyntaxNode_UnaryOperator>(location, p0.value.o, std::move(expr));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPostfix(const char* expected) {
@@ -1006,48 +1073,45 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPostfixGr
                            | postfix-expression '?.' identifier
   */
   for (;;) {
-    auto& p0 = this->backtrack.peek(0);
+    auto& p0 = this->cursor.peek(0);
     if (p0.isOperator(EggTokenizerOperator::BracketLeft)) {
       // Expect <expression> '[' <expression> ']' 
       EggSyntaxNodeLocation location(p0, 0);
-      EggSyntaxParserBacktrackMark mark(this->backtrack);
-      mark.advance(1);
+      this->cursor.advance(1);
       auto index = this->parseExpression("Expected expression inside indexing '[]' operators");
-      auto& p1 = mark.peek(0);
+      auto& p1 = this->cursor.peek(0);
       if (!p1.isOperator(EggTokenizerOperator::BracketRight)) {
         this->unexpected("Expected ']' after indexing expression following '['", p1);
       }
       location.setLocationEnd(p1, 1);
-      mark.accept(1);
-      expr = std::make_unique<EggSyntaxNode_BinaryOperator>(location, EggTokenizerOperator::BracketLeft, std::move(expr), std::move(index));
+      this->cursor.advance(1);
+      expr = this->make<EggSyntaxNode_BinaryOperator>(location, EggTokenizerOperator::BracketLeft, std::move(expr), std::move(index));
     } else if (p0.isOperator(EggTokenizerOperator::ParenthesisLeft)) {
       // Expect <expression> '(' <parameter-list>? ')'
       expr = this->parseExpressionPostfixFunctionCall(std::move(expr));
     } else if (p0.isOperator(EggTokenizerOperator::Dot)) {
       // Expect <expression> '.' <identifer>
       EggSyntaxNodeLocation location(p0, 1);
-      EggSyntaxParserBacktrackMark mark(this->backtrack);
-      auto& p1 = mark.peek(1);
+      auto& p1 = this->cursor.peek(1);
       if (p1.kind != EggTokenizerKind::Identifier) {
         this->unexpected("Expected property name to follow '.' operator", p1);
       }
-      expr = std::make_unique<EggSyntaxNode_Dot>(location, std::move(expr), p1.value.s, false);
-      mark.accept(2);
+      expr = this->make<EggSyntaxNode_Dot>(location, std::move(expr), p1.value.s, false);
+      this->cursor.advance(2);
     } else if (p0.isOperator(EggTokenizerOperator::Query)) {
       // Expect <expression> '?.' <identifer>
-      EggSyntaxParserBacktrackMark mark(this->backtrack);
-      auto& p1 = mark.peek(1);
+      auto& p1 = this->cursor.peek(1);
       // We use contiguous sequential operators to disambiguate "a?...x:y" from "a?.b"
       if (!p1.isOperator(EggTokenizerOperator::Dot) || !p1.contiguous) {
         break;
       }
       EggSyntaxNodeLocation location(p0, 2);
-      auto& p2 = mark.peek(2);
+      auto& p2 = this->cursor.peek(2);
       if (p2.kind != EggTokenizerKind::Identifier) {
         this->unexpected("Expected property name to follow '?.' operator", p2);
       }
-      expr = std::make_unique<EggSyntaxNode_Dot>(location, std::move(expr), p2.value.s, true);
-      mark.accept(3);
+      expr = this->make<EggSyntaxNode_Dot>(location, std::move(expr), p2.value.s, true);
+      this->cursor.advance(3);
     } else {
       // No postfix operator, return just the expression
       break;
@@ -1073,44 +1137,42 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPostfixFu
 
       named-parameter ::= variable-identifier ':' expression
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisLeft));
-  EggSyntaxNodeLocation location(mark.peek(0), 0);
-  auto call = std::make_unique<EggSyntaxNode_Call>(location, std::move(callee));
-  if (mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisLeft));
+  EggSyntaxNodeLocation location(this->cursor.peek(0), 0);
+  auto call = this->make<EggSyntaxNode_Call>(location, std::move(callee));
+  if (this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisRight)) {
     // This is an empty parameter list: '(' ')'
-    mark.accept(1);
+    this->cursor.advance(1);
   } else {
     // Don't worry about the order of positional and named parameters at this stage
     const EggTokenizerItem* p0;
     do {
-      mark.advance(1);
-      p0 = &mark.peek(0);
-      if ((p0->kind == EggTokenizerKind::Identifier) && mark.peek(1).isOperator(EggTokenizerOperator::Colon)) {
+      this->cursor.advance(1);
+      p0 = &this->cursor.peek(0);
+      if ((p0->kind == EggTokenizerKind::Identifier) && this->cursor.peek(1).isOperator(EggTokenizerOperator::Colon)) {
         // Expect <identifier> ':' <expression>
         EggSyntaxNodeLocation plocation(*p0);
-        plocation.setLocationEnd(mark.peek(1), 1);
-        mark.advance(2);
+        plocation.setLocationEnd(this->cursor.peek(1), 1);
+        this->cursor.advance(2);
         auto expr = this->parseExpression("Expected expression for named function call parameter value");
-        auto named = std::make_unique<EggSyntaxNode_Named>(plocation, p0->value.s, std::move(expr));
+        auto named = this->make<EggSyntaxNode_Named>(plocation, p0->value.s, std::move(expr));
         call->addChild(std::move(named));
       } else {
         // Expect <expression>
         auto expr = this->parseExpression("Expected expression for function call parameter value");
         call->addChild(std::move(expr));
       }
-      p0 = &mark.peek(0);
+      p0 = &this->cursor.peek(0);
     } while (p0->isOperator(EggTokenizerOperator::Comma));
     if (!p0->isOperator(EggTokenizerOperator::ParenthesisRight)) {
       this->unexpected("Expected ')' at end of function call parameter list", *p0);
     }
-    mark.accept(0);
   }
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight));
-  call->setLocationEnd(mark.peek(0), 1);
-  mark.accept(1); // skip ')'
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight));
+  call->setLocationEnd(this->cursor.peek(0), 1);
+  this->cursor.advance(1); // skip ')'
   return call;
 }
 
@@ -1124,18 +1186,17 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPrimary(c
                            | '(' expression ')'
                            | cast-specifier '(' expression ')'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   EggSyntaxNodeLocation location(p0);
   switch (p0.kind) {
   case EggTokenizerKind::Integer:
   case EggTokenizerKind::Float:
   case EggTokenizerKind::String:
-    mark.accept(1);
-    return std::make_unique<EggSyntaxNode_Literal>(location, p0.kind, p0.value);
+    this->cursor.advance(1);
+    return this->make<EggSyntaxNode_Literal>(location, p0.kind, p0.value);
   case EggTokenizerKind::Identifier:
-    mark.accept(1);
-    return std::make_unique<EggSyntaxNode_Identifier>(location, p0.value.s);
+    this->cursor.advance(1);
+    return this->make<EggSyntaxNode_Identifier>(location, p0.value.s);
   case EggTokenizerKind::Keyword:
     EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
     switch (p0.value.k) {
@@ -1143,8 +1204,8 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPrimary(c
     case EggTokenizerKeyword::False:
     case EggTokenizerKeyword::True:
       // Literal constant
-      mark.accept(1);
-      return std::make_unique<EggSyntaxNode_Literal>(location, p0.kind, p0.value);
+      this->cursor.advance(1);
+      return this->make<EggSyntaxNode_Literal>(location, p0.kind, p0.value);
     case EggTokenizerKeyword::Bool:
     case EggTokenizerKeyword::Int:
     case EggTokenizerKeyword::Float:
@@ -1152,10 +1213,10 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPrimary(c
     case EggTokenizerKeyword::Object:
     case EggTokenizerKeyword::Type:
       // It could be a constructor like 'string(...)' or a property like 'float.epsilon'
-      auto& p1 = mark.peek(1);
+      auto& p1 = this->cursor.peek(1);
       if (p1.isOperator(EggTokenizerOperator::ParenthesisLeft) || p1.isOperator(EggTokenizerOperator::Dot)) {
-        mark.accept(1);
-        return std::make_unique<EggSyntaxNode_Identifier>(location, p0.value.s);
+        this->cursor.advance(1);
+        return this->make<EggSyntaxNode_Identifier>(location, p0.value.s);
       }
       break;
     }
@@ -1164,17 +1225,14 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionPrimary(c
   case EggTokenizerKind::Operator:
     if (p0.value.o == EggTokenizerOperator::ParenthesisLeft) {
       auto inside = this->parseExpressionParenthesis();
-      mark.accept(0);
       return inside;
     }
     if (p0.value.o == EggTokenizerOperator::BracketLeft) {
       auto array = this->parseExpressionArray(location);
-      mark.accept(0);
       return array;
     }
     if (p0.value.o == EggTokenizerOperator::CurlyLeft) {
       auto object = this->parseExpressionObject(location);
-      mark.accept(0);
       return object;
     }
     break;
@@ -1204,41 +1262,43 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionDeclarati
       expression-declaration ::= keyword '(' variable-definition-type variable-identifier '=' expression ')'
                                | keyword '(' expression ')'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& pk = mark.peek(0);
+  auto& pk = this->cursor.peek(0);
   assert(pk.kind == EggTokenizerKind::Keyword);
   auto keyword = EggTokenizerValue::getKeywordString(pk.value.k);
-  if (!mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
-    this->unexpected("Expected '(' after '" + keyword + "' keyword", mark.peek(1));
+  if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
+    this->unexpected("Expected '(' after '" + keyword + "' keyword", this->cursor.peek(1));
+  }
+  this->cursor.advance(2);
+  std::unique_ptr<IEggSyntaxNode> expr;
+  if (!this->isTypeStart()) {
+    expr = this->parseExpression(nullptr);
   }
-  mark.advance(2);
-  auto expr = this->parseExpression(nullptr);
   if (expr == nullptr) {
     // Expect <keyword> '(' <type> <identifier> '=' <expression> ')' <compound-statement>
     auto type = this->parseType(nullptr);
     if (type == nullptr) {
-      this->unexpected("Expected expression or type after '(' in '" + keyword + "' statement", mark.peek(0));
+      this->unexpected("Expected expression or type after '(' in '" + keyword + "' statement", this->cursor.peek(0));
     }
-    auto& p0 = mark.peek(0);
+    auto& p0 = this->cursor.peek(0);
     if (p0.kind != EggTokenizerKind::Identifier) {
       this->unexpected("Expected variable identifier after type in '" + keyword + "' statement", p0);
     }
-    auto& p1 = mark.peek(1);
+    auto& p1 = this->cursor.peek(1);
     if (!p1.isOperator(EggTokenizerOperator::Equal)) {
       this->unexpected("Expected '=' after variable identifier in '" + keyword + "' statement", p1);
     }
     EggSyntaxNodeLocation location(p0);
-    mark.advance(2);
+    this->cursor.advance(2);
     auto rhs = this->parseExpression(nullptr);
     if (rhs == nullptr) {
-      this->unexpected("Expected expression after '=' in '" + keyword + "' statement", mark.peek(0));
+      this->unexpected("Expected expression after '=' in '" + keyword + "' statement", this->cursor.peek(0));
     }
-    expr = std::make_unique<EggSyntaxNode_Guard>(location, p0.value.s, std::move(type), std::move(rhs));
+    expr = this->make<EggSyntaxNode_Guard>(location, p0.value.s, std::move(type), std::move(rhs));
   }
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
-    this->unexpected("Expected ')' after expression in '" + keyword + "' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+    this->unexpected("Expected ')' after expression in '" + keyword + "' statement", this->cursor.peek(0));
   }
-  mark.accept(1);
+  this->cursor.advance(1);
   return expr;
 }
 
@@ -1246,17 +1306,14 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionParenthes
   /*
       parenthesis-value ::= '(' expression ')'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisLeft));
-  mark.advance(1);
-  auto expr = this->parseExpression(nullptr);
-  if (expr != nullptr) {
-    if (!mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
-      this->unexpected("Expected ')' at end of parenthesized expression", mark.peek(0));
-    }
-    mark.accept(1);
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisLeft));
+  this->cursor.advance(1);
+  auto expr = this->parseExpression("Expected expression after '('");
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+    this->unexpected("Expected ')' at end of parenthesized expression", this->cursor.peek(0));
   }
+  this->cursor.advance(1);
   return expr;
 }
 
@@ -1267,25 +1324,24 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionArray(con
       array-value-list ::= expression
                          | array-value-list ',' expression
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isOperator(EggTokenizerOperator::BracketLeft));
-  auto array = std::make_unique<EggSyntaxNode_Array>(location);
-  if (mark.peek(1).isOperator(EggTokenizerOperator::BracketRight)) {
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::BracketLeft));
+  auto array = this->make<EggSyntaxNode_Array>(location);
+  if (this->cursor.peek(1).isOperator(EggTokenizerOperator::BracketRight)) {
     // This is an empty array: '[' ']'
-    mark.accept(2);
+    this->cursor.advance(2);
   } else {
     const EggTokenizerItem* p;
     do {
-      mark.advance(1);
+      this->cursor.advance(1);
       auto expr = this->parseExpression("Expected expression for array value");
       array->addChild(std::move(expr));
-      p = &mark.peek(0);
+      p = &this->cursor.peek(0);
     } while (p->isOperator(EggTokenizerOperator::Comma));
     if (!p->isOperator(EggTokenizerOperator::BracketRight)) {
       this->unexpected("Expected ']' at end of array expression", *p);
     }
-    mark.accept(1);
+    this->cursor.advance(1);
   }
   return array;
 }
@@ -1297,41 +1353,40 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseExpressionObject(co
       object-value-list ::= name ':' expression
                           | object-value-list ',' name ':' expression
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft));
-  auto object = std::make_unique<EggSyntaxNode_Object>(location);
-  if (mark.peek(1).isOperator(EggTokenizerOperator::CurlyRight)) {
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft));
+  auto object = this->make<EggSyntaxNode_Object>(location);
+  if (this->cursor.peek(1).isOperator(EggTokenizerOperator::CurlyRight)) {
     // This is an empty object: '{' '}'
-    mark.accept(2);
+    this->cursor.advance(2);
   } else {
     std::set<egg::ovum::String> seen;
     const EggTokenizerItem* p;
     do {
       // Expect <identifier> ':' <expression>
-      p = &mark.peek(1);
+      p = &this->cursor.peek(1);
       if (p->kind != EggTokenizerKind::Identifier) {
         this->unexpected("Expected property name in object expression", *p);
       }
       auto name = p->value.s;
       if (!seen.insert(name).second) {
-        mark.advance(1); // Point to the property name so the constructed error message is accurate
+        this->cursor.advance(1); // Point to the property name so the constructed error message is accurate
         this->unexpected("Duplicate property name in object expression: '" + name.toUTF8() + "'");
       }
-      p = &mark.peek(2);
+      p = &this->cursor.peek(2);
       if (!p->isOperator(EggTokenizerOperator::Colon)) {
         this->unexpected("Expected ':' after property name in object expression", *p);
       }
-      mark.advance(3);
+      this->cursor.advance(3);
       auto expr = this->parseExpression("Expected expression after ':' in object expression");
-      auto named = std::make_unique<EggSyntaxNode_Named>(location, name, std::move(expr));
+      auto named = this->make<EggSyntaxNode_Named>(location, name, std::move(expr));
       object->addChild(std::move(named));
-      p = &mark.peek(0);
+      p = &this->cursor.peek(0);
     } while (p->isOperator(EggTokenizerOperator::Comma));
     if (!p->isOperator(EggTokenizerOperator::CurlyRight)) {
       this->unexpected("Expected '}' at end of object expression", *p);
     }
-    mark.accept(1);
+    this->cursor.advance(1);
   }
   return object;
 }
@@ -1359,8 +1414,7 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementAssignment
                             | '|='
                             | '||='
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   const char* expected = nullptr;
   if (p0.kind == EggTokenizerKind::Operator) {
     auto key = EggTokenizerValue::getOperatorString(p0.value.o);
@@ -1370,62 +1424,61 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementAssignment
     this->unexpected("Expected assignment operator after expression", p0);
   }
   EggSyntaxNodeLocation location(p0);
-  mark.advance(1);
+  this->cursor.advance(1);
   auto rhs = this->parseExpression(expected);
-  auto& px = mark.peek(0);
+  auto& px = this->cursor.peek(0);
   if (!px.isOperator(terminal)) {
     this->unexpected("Expected '" + EggTokenizerValue::getOperatorString(terminal) + "' after assignment statement", px);
   }
-  mark.accept(1);
-  return std::make_unique<EggSyntaxNode_Assignment>(location, p0.value.o, std::move(lhs), std::move(rhs));
+  this->cursor.advance(1);
+  return this->make<EggSyntaxNode_Assignment>(location, p0.value.o, std::move(lhs), std::move(rhs));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementBreak() {
   /*
       break-statement ::= 'break' ';'
   */
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Break));
-  auto& p1 = this->backtrack.peek(1);
+  auto& p1 = this->cursor.peek(1);
   if (!p1.isOperator(EggTokenizerOperator::Semicolon)) {
     this->unexpected("Expected ';' after 'break' keyword", p1);
   }
   EggSyntaxNodeLocation location(p0);
-  this->backtrack.advance(2);
-  return std::make_unique<EggSyntaxNode_Break>(location);
+  this->cursor.advance(2);
+  return this->make<EggSyntaxNode_Break>(location);
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementCase() {
   /*
       case-statement ::= 'case' <expression> ':'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Case));
-  mark.advance(1);
+  this->cursor.advance(1);
   auto expr = this->parseExpression("Expected expression after 'case' keyword");
-  auto& px = mark.peek(0);
+  auto& px = this->cursor.peek(0);
   if (!px.isOperator(EggTokenizerOperator::Colon)) {
     this->unexpected("Expected colon after 'case' expression", px);
   }
   EggSyntaxNodeLocation location(p0);
-  mark.accept(1);
-  return std::make_unique<EggSyntaxNode_Case>(location, std::move(expr));
+  this->cursor.advance(1);
+  return this->make<EggSyntaxNode_Case>(location, std::move(expr));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementContinue() {
   /*
       continue-statement ::= 'continue' ';'
   */
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Continue));
-  auto& p1 = this->backtrack.peek(1);
+  auto& p1 = this->cursor.peek(1);
   if (!p1.isOperator(EggTokenizerOperator::Semicolon)) {
     this->unexpected("Expected ';' after 'continue' keyword", p1);
   }
   EggSyntaxNodeLocation location(p0);
-  this->backtrack.advance(2);
-  return std::make_unique<EggSyntaxNode_Continue>(location);
+  this->cursor.advance(2);
+  return this->make<EggSyntaxNode_Continue>(location);
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementDecrementIncrement(EggTokenizerOperator op, const std::string& what, const char* expected, EggTokenizerOperator terminal) {
@@ -1434,74 +1487,72 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementDecrementI
                              | '++' assignment-target
                              | '--' assignment-target
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isOperator(op));
-  mark.advance(1);
+  this->cursor.advance(1);
   auto expr = this->parseExpression(expected);
-  auto& px = mark.peek(0);
+  auto& px = this->cursor.peek(0);
   if (!px.isOperator(terminal)) {
     this->unexpected("Expected '" + EggTokenizerValue::getOperatorString(terminal) + "' after " + what + " statement", px);
   }
   EggSyntaxNodeLocation location(p0);
-  mark.accept(1);
-  return std::make_unique<EggSyntaxNode_Mutate>(location, op, std::move(expr));
+  this->cursor.advance(1);
+  return this->make<EggSyntaxNode_Mutate>(location, op, std::move(expr));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementDefault() {
   /*
       default-statement ::= 'default' ':'
   */
-  auto& p0 = this->backtrack.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Default));
-  auto& p1 = this->backtrack.peek(1);
+  auto& p1 = this->cursor.peek(1);
   if (!p1.isOperator(EggTokenizerOperator::Colon)) {
     this->unexpected("Expected colon after 'default' keyword", p1);
   }
   EggSyntaxNodeLocation location(p0);
-  this->backtrack.advance(2);
-  return std::make_unique<EggSyntaxNode_Default>(location);
+  this->cursor.advance(2);
+  return this->make<EggSyntaxNode_Default>(location);
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementDo() {
   /*
       do-statement ::= 'do' <compound-statement> 'while' '(' <expression> ')' ';'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Do));
   EggSyntaxNodeLocation location(p0);
-  mark.advance(1);
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after 'do' keyword", mark.peek(0));
+  this->cursor.advance(1);
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after 'do' keyword", this->cursor.peek(0));
   }
   auto block = this->parseCompoundStatement();
-  if (!mark.peek(0).isKeyword(EggTokenizerKeyword::While)) {
-    this->unexpected("Expected 'while' after '}' in 'do' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isKeyword(EggTokenizerKeyword::While)) {
+    this->unexpected("Expected 'while' after '}' in 'do' statement", this->cursor.peek(0));
   }
-  if (!mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
-    this->unexpected("Expected '(' after 'while' keyword in 'do' statement", mark.peek(1));
+  if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
+    this->unexpected("Expected '(' after 'while' keyword in 'do' statement", this->cursor.peek(1));
   }
-  mark.advance(2);
+  this->cursor.advance(2);
   auto expr = this->parseCondition("Expected condition expression after 'while (' in 'do' statement");
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
-    this->unexpected("Expected ')' after 'do' condition expression", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+    this->unexpected("Expected ')' after 'do' condition expression", this->cursor.peek(0));
   }
-  if (!mark.peek(1).isOperator(EggTokenizerOperator::Semicolon)) {
-    this->unexpected("Expected ';' after ')' at end of 'do' statement", mark.peek(1));
+  if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::Semicolon)) {
+    this->unexpected("Expected ';' after ')' at end of 'do' statement", this->cursor.peek(1));
   }
-  mark.accept(2);
-  return std::make_unique<EggSyntaxNode_Do>(location, std::move(expr), std::move(block));
+  this->cursor.advance(2);
+  return this->make<EggSyntaxNode_Do>(location, std::move(expr), std::move(block));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementExpression(std::unique_ptr<IEggSyntaxNode>&& expr, EggTokenizerOperator terminal) {
   // Expect <lhs> <assignment-operator> <rhs> ';'
   //     or <function-call> ';'
-  if (!this->backtrack.peek(0).isOperator(terminal)) {
+  if (!this->cursor.peek(0).isOperator(terminal)) {
     return this->parseStatementAssignment(std::move(expr), terminal);
   }
   // Assume function call expression
-  this->backtrack.advance(1);
+  this->cursor.advance(1);
   return std::move(expr);
 }
 
@@ -1510,131 +1561,179 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementFor() {
       for-statement ::= 'for' '(' simple-statement? ';' condition? ';' simple-statement? ')' compound-statement
                       | 'for' '(' variable-definition-type? variable-identifier ':' expression ')' compound-statement
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::For));
-  if (!mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
-    this->unexpected("Expected '(' after 'for' keyword", mark.peek(1));
+  if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
+    this->unexpected("Expected '(' after 'for' keyword", this->cursor.peek(1));
   }
-  auto foreach = this->parseStatementForeach();
-  if (foreach != nullptr) {
-    mark.accept(0);
+  if (this->isStatementForeach()) {
+    auto foreach = this->parseStatementForeach();
     return foreach;
   }
   EggSyntaxNodeLocation forLocation(p0);
-  mark.advance(2);
+  this->cursor.advance(2);
   std::unique_ptr<IEggSyntaxNode> pre, cond, post;
-  if (mark.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
-    mark.advance(1); // skip ';'
+  if (this->cursor.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
+    this->cursor.advance(1); // skip ';'
   } else {
     pre = this->parseStatementSimple("Expected simple statement after '(' in 'for' statement", EggTokenizerOperator::Semicolon);
   }
-  if (mark.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
-    mark.advance(1); // skip ';'
+  if (this->cursor.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
+    this->cursor.advance(1); // skip ';'
   } else {
     cond = this->parseCondition("Expected condition expression as second clause in 'for' statement");
-    if (!mark.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
-      this->unexpected("Expected ';' after condition expression of 'for' statement", mark.peek(0));
+    if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
+      this->unexpected("Expected ';' after condition expression of 'for' statement", this->cursor.peek(0));
     }
-    mark.advance(1); // skip ';'
+    this->cursor.advance(1); // skip ';'
   }
-  if (mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
-    mark.advance(1); // skip ')'
+  if (this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+    this->cursor.advance(1); // skip ')'
   } else {
     post = this->parseStatementSimple("Expected simple statement as third clause in 'for' statement", EggTokenizerOperator::ParenthesisRight);
   }
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after ')' in 'for' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after ')' in 'for' statement", this->cursor.peek(0));
   }
   auto block = this->parseCompoundStatement();
-  mark.accept(0);
-  return std::make_unique<EggSyntaxNode_For>(forLocation, std::move(pre), std::move(cond), std::move(post), std::move(block));
+  return this->make<EggSyntaxNode_For>(forLocation, std::move(pre), std::move(cond), std::move(post), std::move(block));
+}
+
+bool EggSyntaxParserContext::isStatementForeach() {
+  // Look for a top-level ':' that is not part of a ternary operator before the first top-level ';' or ')'
+  // cppcheck-suppress assertWithSideEffect
+  assert(this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft));
+  size_t depth = 0;
+  size_t ternaries = 0;
+  for (size_t index = 2;; ++index) {
+    auto& p = this->cursor.peek(index);
+    if (p.kind == EggTokenizerKind::EndOfFile) {
+      return false;
+    }
+    if (p.kind == EggTokenizerKind::Operator) {
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN();
+      switch (p.value.o) {
+      case EggTokenizerOperator::ParenthesisLeft:
+      case EggTokenizerOperator::BracketLeft:
+      case EggTokenizerOperator::CurlyLeft:
+        depth++;
+        break;
+      case EggTokenizerOperator::ParenthesisRight:
+      case EggTokenizerOperator::BracketRight:
+      case EggTokenizerOperator::CurlyRight:
+        if (depth == 0) {
+          return false;
+        }
+        depth--;
+        break;
+      case EggTokenizerOperator::Semicolon:
+        if (depth == 0) {
+          return false;
+        }
+        break;
+      case EggTokenizerOperator::Query:
+        if (depth == 0) {
+          // Ignore '?.' property access
+          auto& q = this->cursor.peek(index + 1);
+          if (!q.isOperator(EggTokenizerOperator::Dot) || !q.contiguous) {
+            ternaries++;
+          }
+        }
+        break;
+      case EggTokenizerOperator::Colon:
+        if (depth == 0) {
+          if (ternaries == 0) {
+            return true;
+          }
+          ternaries--;
+        }
+        break;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END();
+    }
+  }
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementForeach() {
   /*
       foreach-statement ::= 'for' '(' variable-definition-type? variable-identifier ':' expression ')' compound-statement
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isKeyword(EggTokenizerKeyword::For));
+  assert(this->cursor.peek(0).isKeyword(EggTokenizerKeyword::For));
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft));
-  mark.advance(2);
+  assert(this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft));
+  this->cursor.advance(2);
   std::unique_ptr<IEggSyntaxNode> target;
-  auto type = this->parseType(nullptr);
-  if (type != nullptr) {
+  if (this->isTypeStart()) {
+    auto type = this->parseType(nullptr);
+    if (type == nullptr) {
+      this->unexpected("Expected type in 'for' statement", this->cursor.peek(0));
+    }
     // Expect <type> <identifier> ':' <expression>
-    auto& p0 = mark.peek(0);
+    auto& p0 = this->cursor.peek(0);
     if (p0.kind != EggTokenizerKind::Identifier) {
-      return nullptr;
+      this->unexpected("Expected variable identifier after type in 'for' statement", p0);
     }
-    target = std::make_unique<EggSyntaxNode_Declare>(EggSyntaxNodeLocation(p0), p0.value.s, std::move(type));
-    mark.advance(1);
+    target = this->make<EggSyntaxNode_Declare>(EggSyntaxNodeLocation(p0), p0.value.s, std::move(type));
+    this->cursor.advance(1);
   } else {
     // Expect <expression> ':' <expression>
-    target = this->parseExpression(nullptr);
-    if (target == nullptr) {
-      return nullptr;
-    }
+    target = this->parseExpression("Expected variable or expression before ':' in 'for' statement");
   }
   // Expect ':' <expression> ')' <compound-statement>
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::Colon)) {
-    return nullptr;
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::Colon)) {
+    this->unexpected("Expected ':' after variable in 'for' statement", this->cursor.peek(0));
   }
-  EggSyntaxNodeLocation location(mark.peek(0), 1);
-  mark.advance(1);
+  EggSyntaxNodeLocation location(this->cursor.peek(0), 1);
+  this->cursor.advance(1);
   auto expr = this->parseExpression("Expected expression after ':' in 'for' statement");
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
-    this->unexpected("Expected ')' after expression in 'for' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+    this->unexpected("Expected ')' after expression in 'for' statement", this->cursor.peek(0));
   }
-  mark.advance(1);
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after ')' in 'for' statement", mark.peek(0));
+  this->cursor.advance(1);
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after ')' in 'for' statement", this->cursor.peek(0));
   }
   auto block = this->parseCompoundStatement();
-  mark.accept(0);
-  return std::make_unique<EggSyntaxNode_Foreach>(location, std::move(target), std::move(expr), std::move(block));
+  return this->make<EggSyntaxNode_Foreach>(location, std::move(target), std::move(expr), std::move(block));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementFunction(std::unique_ptr<IEggSyntaxNode>&& type, bool generator) {
   // Already consumed <type>
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.kind == EggTokenizerKind::Identifier);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft));
-  auto result = std::make_unique<EggSyntaxNode_FunctionDefinition>(EggSyntaxNodeLocation(p0), p0.value.s, std::move(type), generator);
-  mark.advance(2);
-  while (!mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+  assert(this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft));
+  auto result = this->make<EggSyntaxNode_FunctionDefinition>(EggSyntaxNodeLocation(p0), p0.value.s, std::move(type), generator);
+  this->cursor.advance(2);
+  while (!this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight)) {
     auto ptype = this->parseType("Expected parameter type in function definition");
-    auto& p1 = mark.peek(0);
+    auto& p1 = this->cursor.peek(0);
     if (p1.kind != EggTokenizerKind::Identifier) {
       this->unexpected("Expected identifier after parameter type in function definition", p1);
     }
     EggSyntaxNodeLocation location(p1);
-    mark.advance(1);
-    auto optional = mark.peek(0).isOperator(EggTokenizerOperator::Equal);
+    this->cursor.advance(1);
+    auto optional = this->cursor.peek(0).isOperator(EggTokenizerOperator::Equal);
     if (optional) {
-      auto& p2 = mark.peek(1);
+      auto& p2 = this->cursor.peek(1);
       if (!p2.isKeyword(EggTokenizerKeyword::Null)) {
         this->unexpected("Expected 'null' as default value for parameter '" + p1.value.s.toUTF8() + "'", p2);
       }
-      mark.advance(2);
+      this->cursor.advance(2);
     }
-    auto parameter = std::make_unique<EggSyntaxNode_Parameter>(location, p1.value.s, std::move(ptype), optional);
+    auto parameter = this->make<EggSyntaxNode_Parameter>(location, p1.value.s, std::move(ptype), optional);
     result->addChild(std::move(parameter));
-    auto& p3 = mark.peek(0);
+    auto& p3 = this->cursor.peek(0);
     if (p3.isOperator(EggTokenizerOperator::Comma)) {
-      mark.advance(1);
+      this->cursor.advance(1);
     } else if (!p3.isOperator(EggTokenizerOperator::ParenthesisRight)) {
       this->unexpected("Expected ',' or ')' after parameter in function definition", p3);
     }
   }
-  mark.advance(1); // Skip ')'
+  this->cursor.advance(1); // Skip ')'
   auto block = this->parseCompoundStatement();
   result->addChild(std::move(block));
-  mark.accept(0);
   return result;
 }
 
@@ -1645,19 +1744,18 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementIf() {
       else-clause ::= 'else' <compound-statement>
                     | 'else' <if-statement>
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::If));
   auto expr = this->parseExpressionDeclaration();
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after ')' in 'if' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after ')' in 'if' statement", this->cursor.peek(0));
   }
   EggSyntaxNodeLocation location(p0);
   auto block = this->parseCompoundStatement();
-  auto result = std::make_unique<EggSyntaxNode_If>(location, std::move(expr), std::move(block));
-  if (mark.peek(0).isKeyword(EggTokenizerKeyword::Else)) {
-    auto& p1 = mark.peek(1);
-    mark.advance(1);
+  auto result = this->make<EggSyntaxNode_If>(location, std::move(expr), std::move(block));
+  if (this->cursor.peek(0).isKeyword(EggTokenizerKeyword::Else)) {
+    auto& p1 = this->cursor.peek(1);
+    this->cursor.advance(1);
     if (p1.isOperator(EggTokenizerOperator::CurlyLeft)) {
       result->addChild(this->parseCompoundStatement());
     } else if (p1.isKeyword(EggTokenizerKeyword::If)) {
@@ -1666,7 +1764,6 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementIf() {
       this->unexpected("Expected '{' after 'else' in 'if' statement", p1);
     }
   }
-  mark.accept(0);
   return result;
 }
 
@@ -1674,20 +1771,19 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementReturn() {
   /*
       return-statement ::= 'return' expression? ';'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Return));
-  auto results = std::make_unique<EggSyntaxNode_Return>(EggSyntaxNodeLocation(p0));
-  mark.advance(1);
+  auto results = this->make<EggSyntaxNode_Return>(EggSyntaxNodeLocation(p0));
+  this->cursor.advance(1);
   auto expr = this->parseExpression(nullptr);
   if (expr != nullptr) {
     results->addChild(std::move(expr));
   }
-  auto& px = mark.peek(0);
+  auto& px = this->cursor.peek(0);
   if (!px.isOperator(EggTokenizerOperator::Semicolon)) {
     this->unexpected("Expected ';' at end of 'return' statement", px);
   }
-  mark.accept(1);
+  this->cursor.advance(1);
   return std::move(results);
 }
 
@@ -1695,39 +1791,36 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementSwitch() {
   /*
       switch-statement ::= 'switch' '(' <condition-expression> ')' <compound-statement>
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Switch));
   auto expr = this->parseExpressionDeclaration();
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after ')' in 'switch' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after ')' in 'switch' statement", this->cursor.peek(0));
   }
   EggSyntaxNodeLocation location(p0);
   auto block = this->parseCompoundStatement();
-  mark.accept(0);
-  return std::make_unique<EggSyntaxNode_Switch>(location, std::move(expr), std::move(block));
+  return this->make<EggSyntaxNode_Switch>(location, std::move(expr), std::move(block));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementThrow() {
   /*
       throw-statement ::= 'throw' expression? ';'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Throw));
   EggSyntaxNodeLocation location(p0);
-  mark.advance(1);
+  this->cursor.advance(1);
   auto expr = this->parseExpression(nullptr);
-  auto result = std::make_unique<EggSyntaxNode_Throw>(location);
+  auto result = this->make<EggSyntaxNode_Throw>(location);
   if (expr != nullptr) {
     result->addChild(std::move(expr));
-    if (!mark.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
-      this->unexpected("Expected ';' at end of 'throw' statement", mark.peek(0));
+    if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
+      this->unexpected("Expected ';' at end of 'throw' statement", this->cursor.peek(0));
     }
-  } else if (!mark.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
-    this->unexpected("Expected expression or ';' after 'throw' keyword", mark.peek(0));
+  } else if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
+    this->unexpected("Expected expression or ';' after 'throw' keyword", this->cursor.peek(0));
   }
-  mark.accept(1);
+  this->cursor.advance(1);
   return std::move(result);
 }
 
@@ -1739,82 +1832,79 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementTry() {
 
       finally-clause ::= 'finally' <compound-statement>
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Try));
   EggSyntaxNodeLocation location0(p0);
-  mark.advance(1);
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after 'try' keyword", mark.peek(0));
+  this->cursor.advance(1);
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after 'try' keyword", this->cursor.peek(0));
   }
   auto block = this->parseCompoundStatement();
-  auto result = std::make_unique<EggSyntaxNode_Try>(location0, std::move(block));
+  auto result = this->make<EggSyntaxNode_Try>(location0, std::move(block));
   size_t catches = 0;
-  while (mark.peek(0).isKeyword(EggTokenizerKeyword::Catch)) {
+  while (this->cursor.peek(0).isKeyword(EggTokenizerKeyword::Catch)) {
     // Expect 'catch' '(' <type> <identifier> ')' <compound-statement>
-    if (!mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
-      this->unexpected("Expected '(' after 'catch' keyword in 'try' statement", mark.peek(1));
+    if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
+      this->unexpected("Expected '(' after 'catch' keyword in 'try' statement", this->cursor.peek(1));
     }
-    EggSyntaxNodeLocation location(mark.peek(0));
-    mark.advance(2);
+    EggSyntaxNodeLocation location(this->cursor.peek(0));
+    this->cursor.advance(2);
     auto type = this->parseType("Expected exception type after '(' in 'catch' clause of 'try' statement");
-    auto& px = mark.peek(0);
+    auto& px = this->cursor.peek(0);
     if (px.kind != EggTokenizerKind::Identifier) {
       this->unexpected("Expected identifier after exception type in 'catch' clause of 'try' statement", px);
     }
     auto name = px.value.s;
-    if (!mark.peek(1).isOperator(EggTokenizerOperator::ParenthesisRight)) {
-      this->unexpected("Expected ')' after identifier in 'catch' clause of 'try' statement", mark.peek(1));
+    if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::ParenthesisRight)) {
+      this->unexpected("Expected ')' after identifier in 'catch' clause of 'try' statement", this->cursor.peek(1));
     }
-    if (!mark.peek(2).isOperator(EggTokenizerOperator::CurlyLeft)) {
-      this->unexpected("Expected '{' after 'catch' clause of 'try' statement", mark.peek(2));
+    if (!this->cursor.peek(2).isOperator(EggTokenizerOperator::CurlyLeft)) {
+      this->unexpected("Expected '{' after 'catch' clause of 'try' statement", this->cursor.peek(2));
     }
-    mark.advance(2);
-    result->addChild(std::make_unique<EggSyntaxNode_Catch>(location, name, std::move(type), this->parseCompoundStatement()));
+    this->cursor.advance(2);
+    result->addChild(this->make<EggSyntaxNode_Catch>(location, name, std::move(type), this->parseCompoundStatement()));
     catches++;
   }
-  if (mark.peek(0).isKeyword(EggTokenizerKeyword::Finally)) {
+  if (this->cursor.peek(0).isKeyword(EggTokenizerKeyword::Finally)) {
     // Expect 'finally' <compound-statement>
-    if (!mark.peek(1).isOperator(EggTokenizerOperator::CurlyLeft)) {
-      this->unexpected("Expected '{' after 'finally' keyword of 'try' statement", mark.peek(1));
+    if (!this->cursor.peek(1).isOperator(EggTokenizerOperator::CurlyLeft)) {
+      this->unexpected("Expected '{' after 'finally' keyword of 'try' statement", this->cursor.peek(1));
     }
-    EggSyntaxNodeLocation location(mark.peek(0));
-    mark.advance(1);
-    result->addChild(std::make_unique<EggSyntaxNode_Finally>(location, this->parseCompoundStatement()));
-    if (mark.peek(0).isKeyword(EggTokenizerKeyword::Catch)) {
+    EggSyntaxNodeLocation location(this->cursor.peek(0));
+    this->cursor.advance(1);
+    result->addChild(this->make<EggSyntaxNode_Finally>(location, this->parseCompoundStatement()));
+    if (this->cursor.peek(0).isKeyword(EggTokenizerKeyword::Catch)) {
       this->unexpected("Unexpected 'catch' clause after 'finally' clause in 'try' statement");
     }
-    if (mark.peek(0).isKeyword(EggTokenizerKeyword::Finally)) {
+    if (this->cursor.peek(0).isKeyword(EggTokenizerKeyword::Finally)) {
       this->unexpected("Unexpected second 'finally' clause in 'try' statement");
     }
   } else if (catches == 0) {
-    this->unexpected("Expected at least one 'catch' or 'finally' clause in 'try' statement", mark.peek(0));
+    this->unexpected("Expected at least one 'catch' or 'finally' clause in 'try' statement", this->cursor.peek(0));
   }
-  mark.accept(0);
   return result;
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementType(std::unique_ptr<IEggSyntaxNode>&& type, bool simple) {
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // Already consumed <type>
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   EggSyntaxNodeLocation location(p0);
   if (p0.kind == EggTokenizerKind::Identifier) {
-    auto& p1 = mark.peek(1);
+    auto& p1 = this->cursor.peek(1);
     if (p1.isOperator(EggTokenizerOperator::Semicolon)) {
       // Found <type> <identifier> ';'
-      mark.accept(2);
-      return std::make_unique<EggSyntaxNode_Declare>(location, p0.value.s, std::move(type));
+      this->cursor.advance(2);
+      return this->make<EggSyntaxNode_Declare>(location, p0.value.s, std::move(type));
     }
     if (p1.isOperator(EggTokenizerOperator::Equal)) {
       // Expect <type> <identifier> = <expression> ';'
-      mark.advance(2);
+      this->cursor.advance(2);
       auto expr = this->parseExpression("Expected expression after assignment '=' operator");
-      if (!mark.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
+      if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::Semicolon)) {
         this->unexpected("Expected ';' at end of initialization statement");
       }
-      mark.accept(1);
-      return std::make_unique<EggSyntaxNode_Declare>(location, p0.value.s, std::move(type), std::move(expr));
+      this->cursor.advance(1);
+      return this->make<EggSyntaxNode_Declare>(location, p0.value.s, std::move(type), std::move(expr));
     }
     if (p1.isOperator(EggTokenizerOperator::ParenthesisLeft)) {
       // Expect <type> <identifier> '(' ... ')' '{' ... '}' with no trailing terminal
@@ -1822,20 +1912,18 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementType(std::
         this->unexpected("Expected simple statement, but got what looks like a function definition");
       }
       auto result = this->parseStatementFunction(std::move(type), false);
-      mark.accept(0);
       return result;
     }
     this->unexpected("Malformed variable declaration or initialization");
   }
   if (p0.isOperator(EggTokenizerOperator::Ellipsis)) {
     // Expect <type> '...' <generator-name> '('
-    if ((mark.peek(1).kind == EggTokenizerKind::Identifier) && mark.peek(2).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
+    if ((this->cursor.peek(1).kind == EggTokenizerKind::Identifier) && this->cursor.peek(2).isOperator(EggTokenizerOperator::ParenthesisLeft)) {
       if (simple) {
         this->unexpected("Expected simple statement, but got what looks like a generator definition");
       }
-      mark.advance(1);
+      this->cursor.advance(1);
       auto result = this->parseStatementFunction(std::move(type), true);
-      mark.accept(0);
       return result;
     }
   }
@@ -1846,17 +1934,15 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementWhile() {
   /*
       while-statement ::= 'while' '(' <condition-expression> ')' <compound-statement>
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::While));
   EggSyntaxNodeLocation location(p0);
   auto expr = this->parseExpressionDeclaration();
-  if (!mark.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
-    this->unexpected("Expected '{' after ')' in 'while' statement", mark.peek(0));
+  if (!this->cursor.peek(0).isOperator(EggTokenizerOperator::CurlyLeft)) {
+    this->unexpected("Expected '{' after ')' in 'while' statement", this->cursor.peek(0));
   }
   auto block = this->parseCompoundStatement();
-  mark.accept(0);
-  return std::make_unique<EggSyntaxNode_While>(location, std::move(expr), std::move(block));
+  return this->make<EggSyntaxNode_While>(location, std::move(expr), std::move(block));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementYield() {
@@ -1864,44 +1950,41 @@ std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseStatementYield() {
       yield-statement ::= 'yield' expression ';'
                         | 'yield' '...' expression ';'
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   assert(p0.isKeyword(EggTokenizerKeyword::Yield));
   EggSyntaxNodeLocation location(p0);
   std::unique_ptr<IEggSyntaxNode> expr;
-  auto& p1 = mark.peek(1);
+  auto& p1 = this->cursor.peek(1);
   if (p1.isOperator(EggTokenizerOperator::Ellipsis)) {
-    mark.advance(2);
+    this->cursor.advance(2);
     auto ellipsis = this->parseExpression("Expected expression after '...' in 'yield' statement");
-    expr = std::make_unique<EggSyntaxNode_UnaryOperator>(location, EggTokenizerOperator::Ellipsis, std::move(ellipsis));
+    expr = this->make<EggSyntaxNode_UnaryOperator>(location, EggTokenizerOperator::Ellipsis, std::move(ellipsis));
   } else {
-    mark.advance(1);
+    this->cursor.advance(1);
     expr = this->parseExpression("Expected expression in 'yield' statement");
   }
-  auto& px = mark.peek(0);
+  auto& px = this->cursor.peek(0);
   if (!px.isOperator(EggTokenizerOperator::Semicolon)) {
     this->unexpected("Expected ';' at end of 'yield' statement", px);
   }
-  mark.accept(1);
-  return std::make_unique<EggSyntaxNode_Yield>(location, std::move(expr));
+  this->cursor.advance(1);
+  return this->make<EggSyntaxNode_Yield>(location, std::move(expr));
 }
 
 std::unique_ptr<IEggSyntaxNode> EggSyntaxParserContext::parseType(const char* expected) {
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   EggSyntaxNodeLocation location(p0);
   if (expected == nullptr) {
     // Allow 'var'
     if (p0.isKeyword(EggTokenizerKeyword::Var)) {
       // Don't allow 'var?'
-      mark.accept(1);
-      return std::make_unique<EggSyntaxNode_Type>(location, nullptr);
+      this->cursor.advance(1);
+      return this->make<EggSyntaxNode_Type>(location, nullptr);
     }
   }
   egg::ovum::Type type{ egg::ovum::Type::Void };
   if (this->parseTypeExpression(type)) {
-    mark.accept(0);
-    return std::make_unique<EggSyntaxNode_Type>(location, type.get());
+    return this->make<EggSyntaxNode_Type>(location, type.get());
   }
   if (expected != nullptr) {
     this->unexpected(expected, p0);
@@ -1917,16 +2000,14 @@ bool EggSyntaxParserContext::parseTypeExpression(egg::ovum::Type& type) {
                               | type-union-expression '|' type-nullable-expression
   */
   if (this->parseTypePostfixExpression(type)) {
-    EggSyntaxParserBacktrackMark mark(this->backtrack);
     egg::ovum::Type other{ egg::ovum::Type::Void };
-    while (mark.peek(0).isOperator(EggTokenizerOperator::Bar)) {
-      mark.advance(1);
+    while (this->cursor.peek(0).isOperator(EggTokenizerOperator::Bar)) {
+      this->cursor.advance(1);
       if (!this->parseTypePostfixExpression(other)) {
-        this->unexpected("Expected type to follow '|' in type expression", mark.peek(0));
+        this->unexpected("Expected type to follow '|' in type expression", this->cursor.peek(0));
       }
       type = egg::ovum::Type::makeUnion(*this->allocator, *type, *other);
     }
-    mark.accept(0);
     return true;
   }
   return false;
@@ -1945,15 +2026,14 @@ bool EggSyntaxParserContext::parseTypePostfixExpression(egg::ovum::Type& type) {
   // TODO arrays, maps, etc.
   if (this->parseTypePrimaryExpression(type)) {
     auto nullabled = false;
-    EggSyntaxParserBacktrackMark mark(this->backtrack);
     for (;;) {
-      auto& p0 = mark.peek(0);
+      auto& p0 = this->cursor.peek(0);
       if (p0.isOperator(EggTokenizerOperator::Query)) {
         // Union 'type' with 'null'
         if (nullabled) {
           this->unexpected("Redundant repetition of '?' in type expression");
         }
-        mark.advance(1);
+        this->cursor.advance(1);
         type = egg::ovum::Type::makeUnion(*this->allocator, *egg::ovum::Type::Null, *type);
         nullabled = true;
         continue;
@@ -1961,7 +2041,7 @@ bool EggSyntaxParserContext::parseTypePostfixExpression(egg::ovum::Type& type) {
       nullabled = false;
       if (p0.isOperator(EggTokenizerOperator::Star)) {
         // Pointer reference to 'type'
-        mark.advance(1);
+        this->cursor.advance(1);
         type = egg::ovum::Type::makePointer(*this->allocator, *type);
         continue;
       }
@@ -1972,7 +2052,6 @@ bool EggSyntaxParserContext::parseTypePostfixExpression(egg::ovum::Type& type) {
       }
       break;
     }
-    mark.accept(0);
     return true;
   }
   return false;
@@ -1986,27 +2065,26 @@ egg::ovum::Type EggSyntaxParserContext::parseTypePostfixFunction(const egg::ovum
       function-parameter ::= attribute* type-expression variable-identifier? ( '=' 'null' )?
                            | attribute* '...' type-expression '[' ']' variable-identifier
   */
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
   // cppcheck-suppress assertWithSideEffect
-  assert(mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisLeft));
-  mark.advance(1);
+  assert(this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisLeft));
+  this->cursor.advance(1);
   auto* underlying = egg::ovum::FunctionType::createFunctionType(*this->allocator, egg::ovum::String(), rettype);
   egg::ovum::Type function{ underlying };
-  for (size_t index = 0; !mark.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight); ++index) {
+  for (size_t index = 0; !this->cursor.peek(0).isOperator(EggTokenizerOperator::ParenthesisRight); ++index) {
     egg::ovum::Type ptype{ egg::ovum::Type::Void };
     if (!this->parseTypeExpression(ptype)) {
-      this->unexpected("Expected parameter type in function type declaration", mark.peek(0));
+      this->unexpected("Expected parameter type in function type declaration", this->cursor.peek(0));
     }
     egg::ovum::String pname;
-    auto& p1 = mark.peek(0);
+    auto& p1 = this->cursor.peek(0);
     if (p1.kind == EggTokenizerKind::Identifier) {
       // Skip the optional parameter name
       pname = p1.value.s;
-      mark.advance(1);
+      this->cursor.advance(1);
     }
     auto flags = egg::ovum::IFunctionSignatureParameter::Flags::Required;
-    if (mark.peek(0).isOperator(EggTokenizerOperator::Equal)) {
-      auto& p2 = mark.peek(1);
+    if (this->cursor.peek(0).isOperator(EggTokenizerOperator::Equal)) {
+      auto& p2 = this->cursor.peek(1);
       if (!p2.isKeyword(EggTokenizerKeyword::Null)) {
         if (pname.empty()) {
           this->unexpected("Expected 'null' as default value for parameter index " + std::to_string(index), p2);
@@ -2014,18 +2092,18 @@ egg::ovum::Type EggSyntaxParserContext::parseTypePostfixFunction(const egg::ovum
           this->unexpected("Expected 'null' as default value for parameter '" + pname.toUTF8() + "'", p2);
         }
       }
-      mark.advance(2);
+      this->cursor.advance(2);
       flags = egg::ovum::IFunctionSignatureParameter::Flags::None;
     }
     underlying->addParameter(pname, ptype, flags);
-    auto& p3 = mark.peek(0);
+    auto& p3 = this->cursor.peek(0);
     if (p3.isOperator(EggTokenizerOperator::Comma)) {
-      mark.advance(1);
+      this->cursor.advance(1);
     } else if (!p3.isOperator(EggTokenizerOperator::ParenthesisRight)) {
       this->unexpected("Expected ',' or ')' after parameter in function type declaration", p3);
     }
   }
-  mark.accept(1); // Skip ')'
+  this->cursor.advance(1); // Skip ')'
   return function;
 }
 
@@ -2050,22 +2128,22 @@ bool EggSyntaxParserContext::parseTypePrimaryExpression(egg::ovum::Type& type) {
   // TODO type { ... }
   // TODO type-identifier
   // TODO '(' type - expression ')'
-  EggSyntaxParserBacktrackMark mark(this->backtrack);
-  auto& p0 = mark.peek(0);
+  auto& p0 = this->cursor.peek(0);
   if (p0.isOperator(EggTokenizerOperator::ParenthesisLeft)) {
-    mark.advance(1);
-    if (this->parseTypeExpression(type)) {
-      auto& px = mark.peek(0);
-      if (px.isOperator(EggTokenizerOperator::ParenthesisRight)) {
-        mark.accept(1);
-        return true;
-      }
+    this->cursor.advance(1);
+    if (!this->parseTypeExpression(type)) {
+      this->unexpected("Expected type expression after '('", this->cursor.peek(0));
     }
-    return false;
+    auto& px = this->cursor.peek(0);
+    if (!px.isOperator(EggTokenizerOperator::ParenthesisRight)) {
+      this->unexpected("Expected ')' at end of parenthesized type expression", px);
+    }
+    this->cursor.advance(1);
+    return true;
   }
   auto basal = keywordToBasal(p0);
   if (basal != egg::ovum::BasalBits::None) {
-    mark.accept(1);
+    this->cursor.advance(1);
     type = egg::ovum::Type::makeBasal(*this->allocator, basal);
     return true;
   }
@@ -37,6 +37,10 @@ namespace egg::yolk {
     explicit EggSyntaxNodeBase(const EggSyntaxNodeLocation& location)
       : EggSyntaxNodeLocation(location) {
     }
+    // Nodes are carved from their syntax tree's arena, which reclaims them all at once
+    static void* operator new(size_t bytes, egg::ovum::IAllocator& arena);
+    static void operator delete(void* allocated, egg::ovum::IAllocator& arena);
+    static void operator delete(void* allocated);
     virtual EggTokenizerKeyword keyword() const;
     virtual const EggSyntaxNodeLocation& location() const;
     virtual const std::vector<std::unique_ptr<IEggSyntaxNode>>* children() const;
@@ -10,7 +10,7 @@
   { egg::yolk::EggTokenizerOperator::key, sizeof(text)-1, text },
 
 namespace {
-  const struct KeywordEntry {
+  constexpr struct KeywordEntry {
     egg::yolk::EggTokenizerKeyword key;
     size_t length;
     char text[16];
@@ -18,7 +18,7 @@ namespace {
   keywords[] = {
     EGG_TOKENIZER_KEYWORDS(EGG_TOKENIZER_KEYWORD_DEFINE)
   };
-  const struct OperatorEntry {
+  constexpr struct OperatorEntry {
     egg::yolk::EggTokenizerOperator key;
     size_t length;
     char text[16];
@@ -26,6 +26,79 @@ namespace {
   operators[] = {
     EGG_TOKENIZER_OPERATORS(EGG_TOKENIZER_OPERATOR_DEFINE)
   };
+
+  // Keywords are at least two characters long so this hash is perfect for the current table
+  constexpr size_t keywordHash(const char* text, size_t length) {
+    auto first = size_t(uint8_t(text[0]));
+    auto second = size_t(uint8_t(text[1]));
+    auto last = size_t(uint8_t(text[length - 1]));
+    return (length + first * 6 + second * 6 + last * 5) & 63;
+  }
+
+  struct KeywordTable {
+    int8_t slot[64];
+    size_t collisions;
+  };
+
+  constexpr KeywordTable makeKeywordTable() {
+    KeywordTable table{};
+    for (auto& slot : table.slot) {
+      slot = -1;
+    }
+    for (size_t index = 0; index < EGG_NELEMS(keywords); ++index) {
+      auto& slot = table.slot[keywordHash(keywords[index].text, keywords[index].length)];
+      if (slot >= 0) {
+        table.collisions++;
+      }
+      slot = int8_t(index);
+    }
+    return table;
+  }
+
+  constexpr auto keywordTable = makeKeywordTable();
+  static_assert(keywordTable.collisions == 0, "Keyword hash is no longer perfect: adjust keywordHash()");
+
+  constexpr size_t operatorTrieCapacity() {
+    // One node for the root plus at most one per operator character
+    size_t capacity = 1;
+    for (auto& entry : operators) {
+      capacity += entry.length;
+    }
+    return capacity;
+  }
+
+  struct OperatorTrie {
+    // Children are indexed by printable ASCII character; zero means no child because the root cannot be one
+    static constexpr size_t Capacity = operatorTrieCapacity();
+    static constexpr uint8_t First = 0x20;
+    static constexpr uint8_t Last = 0x7F;
+    uint8_t child[Capacity][Last - First];
+    int8_t accept[Capacity];
+    size_t nodes;
+  };
+  static_assert(OperatorTrie::Capacity <= 0xFF);
+
+  constexpr OperatorTrie makeOperatorTrie() {
+    OperatorTrie trie{};
+    for (auto& accept : trie.accept) {
+      accept = -1;
+    }
+    trie.nodes = 1;
+    for (size_t index = 0; index < EGG_NELEMS(operators); ++index) {
+      size_t node = 0;
+      for (size_t i = 0; i < operators[index].length; ++i) {
+        auto& next = trie.child[node][uint8_t(operators[index].text[i]) - OperatorTrie::First];
+        if (next == 0) {
+          next = uint8_t(trie.nodes++);
+        }
+        node = next;
+      }
+      trie.accept[node] = int8_t(index);
+    }
+    return trie;
+  }
+
+  constexpr auto operatorTrie = makeOperatorTrie();
 }
 
 std::string egg::yolk::EggTokenizerValue::getKeywordString(EggTokenizerKeyword value) {
@@ -41,29 +114,43 @@ std::string egg::yolk::EggTokenizerValue::getOperatorString(EggTokenizerOperator
 }
 
 bool egg::yolk::EggTokenizerValue::tryParseKeyword(const std::string& text, EggTokenizerKeyword& value) {
-  // OPTIMIZE
-  for (size_t i = 0; i < EGG_NELEMS(keywords); ++i) {
-    if (text == keywords[i].text) {
-      value = keywords[i].key;
-      return true;
-    }
+  auto length = text.size();
+  if ((length < 2) || (length >= sizeof(KeywordEntry::text))) {
+    return false;
+  }
+  auto slot = keywordTable.slot[keywordHash(text.data(), length)];
+  if (slot < 0) {
+    return false;
   }
-  return false;
+  auto& candidate = keywords[slot];
+  if ((candidate.length != length) || (std::memcmp(candidate.text, text.data(), length) != 0)) {
+    return false;
+  }
+  value = candidate.key;
+  return true;
 }
 
 bool egg::yolk::EggTokenizerValue::tryParseOperator(const std::string& text, EggTokenizerOperator& value, size_t& length) {
-  // OPTIMIZE
-  auto* data = text.data();
-  auto size = text.size();
-  for (size_t i = EGG_NELEMS(operators); i > 0; --i) {
-    auto& candidate = operators[i - 1];
-    if ((candidate.length <= size) && (std::strncmp(candidate.text, data, candidate.length) == 0)) {
-      value = candidate.key;
-      length = candidate.length;
-      return true;
+  // Walk the trie remembering the longest operator seen so far
+  size_t node = 0;
+  auto found = false;
+  for (size_t i = 0; i < text.size(); ++i) {
+    auto ch = uint8_t(text[i]);
+    if ((ch < OperatorTrie::First) || (ch >= OperatorTrie::Last)) {
+      break;
+    }
+    node = operatorTrie.child[node][ch - OperatorTrie::First];
+    if (node == 0) {
+      break;
+    }
+    auto accept = operatorTrie.accept[node];
+    if (accept >= 0) {
+      value = operators[accept].key;
+      length = i + 1;
+      found = true;
     }
   }
-  return false;
+  return found;
 }
 
 size_t egg::yolk::EggTokenizerItem::width() const {
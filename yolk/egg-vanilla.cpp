@@ -7,6 +7,8 @@
 #include "yolk/egg-program.h"
 
 namespace {
+  using Flags = egg::ovum::IFunctionSignatureParameter::Flags;
+
   class VanillaBase : public egg::ovum::SoftReferenceCounted<egg::ovum::IObject> {
     EGG_NO_COPY(VanillaBase);
   protected:
@@ -145,6 +147,30 @@ namespace {
   };
   const VanillaArrayIndexSignature VanillaArrayIndexSignature::instance{};
 
+  class VanillaArrayMethodType : public egg::ovum::NotReferenceCounted<egg::ovum::TypeBase> {
+    EGG_NO_COPY(VanillaArrayMethodType);
+  private:
+    egg::ovum::FunctionSignature signature;
+  public:
+    VanillaArrayMethodType(const egg::ovum::String& name, const egg::ovum::Type& rettype)
+      : signature(name, rettype) {
+    }
+    VanillaArrayMethodType& parameter(const egg::ovum::String& name, const egg::ovum::Type& type, Flags flags) {
+      this->signature.addSignatureParameter(name, type, this->signature.getParameterCount(), flags);
+      return *this;
+    }
+    virtual std::pair<std::string, int> toStringPrecedence() const override {
+      return std::make_pair(egg::ovum::Function::signatureToString(this->signature, egg::ovum::Function::Parts::NoNames).toUTF8(), 0);
+    }
+    virtual const egg::ovum::IFunctionSignature* callable() const override {
+      return &this->signature;
+    }
+    virtual egg::ovum::Variant tryAssign(egg::ovum::IExecution& execution, egg::ovum::Variant&, const egg::ovum::Variant&) const override {
+      return execution.raise("Cannot re-assign array methods");
+    }
+    static const VanillaArrayMethodType* find(const std::string& name);
+  };
+
   class VanillaArrayType : public egg::ovum::NotReferenceCounted<egg::ovum::TypeBase> {
     VanillaArrayType(const VanillaArrayType&) = delete;
     VanillaArrayType& operator=(const VanillaArrayType&) = delete;
@@ -154,7 +180,7 @@ namespace {
       if (property == "length") {
         return egg::ovum::Type::Int.get();
       }
-      return nullptr;
+      return VanillaArrayMethodType::find(property);
     }
     virtual std::pair<std::string, int> toStringPrecedence() const override {
       return std::make_pair("any?[]", 0); // TODO
@@ -190,30 +216,55 @@ namespace {
   };
   const VanillaArrayType VanillaArrayType::instance{};
 
+  const VanillaArrayMethodType* VanillaArrayMethodType::find(const std::string& name) {
+    // Built on first use because the basal types are globals in another translation unit
+    using Table = std::map<std::string, std::unique_ptr<VanillaArrayMethodType>>;
+    static const Table table = [] {
+      Table methods;
+      auto method = [&methods](const char* name, const egg::ovum::Type& rettype) -> VanillaArrayMethodType& {
+        auto& entry = methods[name];
+        entry = std::make_unique<VanillaArrayMethodType>(egg::ovum::StringBuilder::concat("array.", name), rettype);
+        return *entry;
+      };
+      egg::ovum::Type array{ &VanillaArrayType::instance };
+      method("concat", array).parameter("arrays", array, Flags::Variadic);
+      method("fill", egg::ovum::Type::Void).parameter("value", egg::ovum::Type::AnyQ, Flags::Required);
+      method("filter", array).parameter("predicate", egg::ovum::Type::Object, Flags::Required);
+      method("indexOf", egg::ovum::Type::AnyQ).parameter("value", egg::ovum::Type::AnyQ, Flags::Required);
+      method("map", array).parameter("mapper", egg::ovum::Type::Object, Flags::Required);
+      method("max", egg::ovum::Type::AnyQ);
+      method("min", egg::ovum::Type::AnyQ);
+      method("reverse", egg::ovum::Type::Void);
+      method("slice", array).parameter("begin", egg::ovum::Type::Int, Flags::Required).parameter("end", egg::ovum::Type::AnyQ, Flags::None);
+      method("sort", egg::ovum::Type::Void).parameter("comparator", egg::ovum::Type::Object, Flags::None);
+      method("sum", egg::ovum::Type::Arithmetic);
+      return methods;
+    }();
+    auto found = table.find(name);
+    if (found == table.end()) {
+      return nullptr;
+    }
+    assert(egg::ovum::PackedArray::findMethod(egg::ovum::String(name)) != nullptr);
+    return found->second.get();
+  }
+
   class VanillaArray : public VanillaBase {
     EGG_NO_COPY(VanillaArray);
   private:
-    std::vector<egg::ovum::Variant> values;
+    egg::ovum::PackedArray elements;
   public:
     explicit VanillaArray(egg::ovum::IAllocator& allocator)
       : VanillaBase(allocator, "Array", VanillaArrayType::instance) {
     }
+    VanillaArray(egg::ovum::IAllocator& allocator, egg::ovum::PackedArray&& elements)
+      : VanillaBase(allocator, "Array", VanillaArrayType::instance), elements(std::move(elements)) {
+    }
     virtual egg::ovum::Variant toString() const override {
-      if (this->values.empty()) {
-        return egg::ovum::Variant(egg::ovum::String("[]"));
-      }
-      egg::ovum::StringBuilder sb;
-      char between = '[';
-      for (auto& value : this->values) {
-        sb.add(between, value.toString());
-        between = ',';
-      }
-      sb.add(']');
-      return egg::ovum::Variant{ sb.str() };
+      return egg::ovum::Variant{ this->elements.toString() };
     }
     virtual egg::ovum::Variant getProperty(egg::ovum::IExecution& execution, const egg::ovum::String& property) override {
       auto name = property.toUTF8();
-      auto retval = this->getPropertyInternal(execution, name);
+      auto retval = this->getPropertyInternal(execution, property);
       if (retval.hasFlowControl()) {
         assert(VanillaArrayType::getPropertyType(name) == nullptr);
       } else {
@@ -233,10 +284,10 @@ namespace {
         return execution.raiseFormat("Array index was expected to be 'int', not '", index.getRuntimeType().toString(), "'");
       }
       auto i = index.getInt();
-      if ((i < 0) || (uint64_t(i) >= uint64_t(this->values.size()))) {
-        return execution.raiseFormat("Invalid array index for an array with ", this->values.size(), " element(s): ", i);
+      if ((i < 0) || (uint64_t(i) >= uint64_t(this->elements.size()))) {
+        return execution.raiseFormat("Invalid array index for an array with ", this->elements.size(), " element(s): ", i);
       }
-      auto& element = this->values.at(size_t(i));
+      auto element = this->elements.get(size_t(i));
       assert(!element.isVoid());
       return element;
     }
@@ -249,34 +300,30 @@ namespace {
         return execution.raiseFormat("Invalid array index: ", i);
       }
       auto u = size_t(i);
-      if (u >= this->values.size()) {
-        this->values.resize(u + 1, egg::ovum::Variant::Null);
+      if (u > this->elements.size()) {
+        this->elements.resize(u);
       }
-      this->values[u] = value;
+      (void)this->elements.set(u, value);
       return egg::ovum::Variant::Void;
     }
     virtual egg::ovum::Variant iterate(egg::ovum::IExecution& execution) override;
     egg::ovum::Variant iterateNext(size_t& index) const {
       // Used by VanillaArrayIterator
       // TODO What if the array has been modified?
-      if (index < this->values.size()) {
-        return this->values.at(index++);
+      if (index < this->elements.size()) {
+        return this->elements.get(index++);
       }
       return egg::ovum::Variant::Void;
     }
-  private:
-    egg::ovum::Variant getPropertyInternal(egg::ovum::IExecution& execution, const std::string& property) {
-      if (property == "length") {
-        return egg::ovum::Variant{ int64_t(this->values.size()) };
-      }
-      return execution.raiseFormat("Arrays do not support property '.", property, "'");
-    }
-    egg::ovum::Variant setPropertyInternal(egg::ovum::IExecution& execution, const std::string& property, const egg::ovum::Variant& value) {
-      if (property == "length") {
-        return this->setLength(execution, value);
-      }
-      return execution.raiseFormat("Arrays do not support property '.", property, "'");
+    egg::ovum::Variant invoke(egg::ovum::IExecution& execution, egg::ovum::PackedArray::Method method, const egg::ovum::IParameters& parameters) {
+      // Used by VanillaArrayMethod
+      auto factory = [&execution](egg::ovum::PackedArray&& result) {
+        return egg::ovum::VariantFactory::createObject<VanillaArray>(execution.getAllocator(), std::move(result));
+      };
+      return (this->elements.*method)(execution, parameters, factory);
     }
+  private:
+    egg::ovum::Variant getPropertyInternal(egg::ovum::IExecution& execution, const egg::ovum::String& property);
     egg::ovum::Variant setLength(egg::ovum::IExecution& execution, const egg::ovum::Variant& value) {
       if (!value.isInt()) {
         return execution.raiseFormat("Array length was expected to be set to an 'int', not '", value.getRuntimeType().toString(), "'");
@@ -285,12 +332,50 @@ namespace {
       if ((n < 0) || (n >= 0x7FFFFFFF)) {
         return execution.raiseFormat("Invalid array length: ", n);
       }
-      auto u = size_t(n);
-      this->values.resize(u, egg::ovum::Variant::Null);
+      this->elements.resize(size_t(n));
       return egg::ovum::Variant::Void;
     }
   };
 
+  class VanillaArrayMethod : public VanillaBase {
+    EGG_NO_COPY(VanillaArrayMethod);
+  private:
+    egg::ovum::HardPtr<VanillaArray> array;
+    egg::ovum::String name;
+    egg::ovum::PackedArray::Method method;
+  public:
+    VanillaArrayMethod(egg::ovum::IAllocator& allocator, VanillaArray& array, const egg::ovum::String& name, egg::ovum::PackedArray::Method method)
+      : VanillaBase(allocator, "Array method", *VanillaArrayMethodType::find(name.toUTF8())), array(&array), name(name), method(method) {
+      assert(method != nullptr);
+    }
+    virtual egg::ovum::Variant toString() const override {
+      return egg::ovum::Variant{ egg::ovum::StringBuilder::concat("<array.", this->name, '>') };
+    }
+    virtual egg::ovum::Variant call(egg::ovum::IExecution& execution, const egg::ovum::IParameters& parameters) override {
+      return this->array->invoke(execution, this->method, parameters);
+    }
+    virtual egg::ovum::Variant getProperty(egg::ovum::IExecution& execution, const egg::ovum::String& property) override {
+      return execution.raiseFormat("Array methods do not support properties: '.", property, "'");
+    }
+    virtual egg::ovum::Variant setProperty(egg::ovum::IExecution& execution, const egg::ovum::String& property, const egg::ovum::Variant&) override {
+      return execution.raiseFormat("Array methods do not support properties: '.", property, "'");
+    }
+    virtual egg::ovum::Variant iterate(egg::ovum::IExecution& execution) override {
+      return execution.raise("Array methods do not support iteration");
+    }
+  };
+
+  egg::ovum::Variant VanillaArray::getPropertyInternal(egg::ovum::IExecution& execution, const egg::ovum::String& property) {
+    if (property.equals("length")) {
+      return egg::ovum::Variant{ int64_t(this->elements.size()) };
+    }
+    auto method = egg::ovum::PackedArray::findMethod(property);
+    if (method != nullptr) {
+      return egg::ovum::VariantFactory::createObject<VanillaArrayMethod>(execution.getAllocator(), *this, property, method);
+    }
+    return execution.raiseFormat("Arrays do not support property '.", property, "'");
+  }
+
   class VanillaArrayIterator : public VanillaIteratorBase {
     EGG_NO_COPY(VanillaArrayIterator);
   private:
@@ -14,15 +14,17 @@ class egg::yolk::EggProgramStackless {
 protected:
   FunctionCoroutineStackless* parent; // back-pointer
   EggProgramStackless* next; // next in stack, may be null
+  size_t bytes; // size of the recyclable allocation
   explicit EggProgramStackless(FunctionCoroutineStackless& parent); 
 public:
   virtual ~EggProgramStackless() {}
   virtual egg::ovum::Variant resume(egg::yolk::EggProgramContext& context) = 0;
   template<typename T, typename... ARGS>
-  T& push(egg::ovum::IAllocator& allocator, ARGS&&... args) {
-    // Use perfect forwarding to the constructor (automatically plumbed into the parent)
-    return *allocator.create<T>(0, *this->parent, std::forward<ARGS>(args)...);
+  T& push(ARGS&&... args) {
+    return EggProgramStackless::create<T>(*this->parent, std::forward<ARGS>(args)...);
   }
+  template<typename T, typename... ARGS>
+  static T& create(FunctionCoroutineStackless& parent, ARGS&&... args);
   EggProgramStackless* pop();
 };
 
@@ -246,9 +248,14 @@ namespace {
     EGG_NO_COPY(FunctionCoroutineStackless);
     friend class egg::yolk::EggProgramStackless;
   private:
+    struct Recycled {
+      size_t bytes;
+      void* allocated;
+    };
     // We cannot use a std::stack for this as the destruction order of elements is undefined by the standard
     egg::yolk::EggProgramStackless* stack;
     std::shared_ptr<egg::yolk::IEggProgramNode> block;
+    std::vector<Recycled> recycled; // Popped frames kept for reuse by later pushes
   public:
     FunctionCoroutineStackless(egg::ovum::IAllocator& allocator, const std::shared_ptr<egg::yolk::IEggProgramNode>& block)
       : HardReferenceCounted(allocator, 0),
@@ -260,16 +267,35 @@ namespace {
       while (this->stack != nullptr) {
         (void)this->stack->pop();
       }
+      for (auto& entry : this->recycled) {
+        this->allocator.deallocate(entry.allocated, alignof(std::max_align_t));
+      }
     }
     virtual egg::ovum::Variant resume(egg::yolk::EggProgramContext& context) override {
       if (this->stack == nullptr) {
         // This is the first time through; push a root context
-        auto* root = allocator.create<StacklessRoot>(0, *this);
-        assert(this->stack == root);
-        return this->block->coexecute(context, *root);
+        auto& root = egg::yolk::EggProgramStackless::create<StacklessRoot>(*this);
+        assert(this->stack == &root);
+        return this->block->coexecute(context, root);
       }
       return this->stack->resume(context);
     }
+  private:
+    void* claim(size_t bytes) {
+      // Loops push and pop the same few frame types repeatedly, so an exact size match is usual
+      for (auto i = this->recycled.rbegin(); i != this->recycled.rend(); ++i) {
+        if (i->bytes == bytes) {
+          auto* allocated = i->allocated;
+          *i = this->recycled.back();
+          this->recycled.pop_back();
+          return allocated;
+        }
+      }
+      return this->allocator.allocate(bytes, alignof(std::max_align_t));
+    }
+    void recycle(void* allocated, size_t bytes) {
+      this->recycled.push_back({ bytes, allocated });
+    }
   };
 }
 
@@ -308,35 +334,49 @@ egg::ovum::HardPtr<egg::yolk::FunctionCoroutine> egg::yolk::FunctionCoroutine::c
 
 egg::yolk::EggProgramStackless::EggProgramStackless(FunctionCoroutineStackless& parent)
   : parent(&parent),
-    next(parent.stack) {
+    next(parent.stack),
+    bytes(0) {
   // Plumb ourselves into the synthetic stack
   parent.stack = this;
 }
 
+template<typename T, typename... ARGS>
+T& egg::yolk::EggProgramStackless::create(FunctionCoroutineStackless& parent, ARGS&&... args) {
+  // Use perfect forwarding to the constructor (automatically plumbed into the parent)
+  static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned stackless frame");
+  auto* allocated = parent.claim(sizeof(T));
+  auto* created = new(allocated) T(parent, std::forward<ARGS>(args)...);
+  static_cast<EggProgramStackless*>(created)->bytes = sizeof(T);
+  return *created;
+}
+
 egg::yolk::EggProgramStackless* egg::yolk::EggProgramStackless::pop() {
   // Remove the top element of the synthetic stack (should be us!)
   auto* top = this->parent->stack;
   assert(top != nullptr);
   assert(top == this);
   auto* result = top->next;
-  this->parent->stack = result;
-  top->parent->allocator.destroy(top);
+  auto* parent = top->parent;
+  auto bytes = top->bytes;
+  parent->stack = result;
+  top->~EggProgramStackless();
+  parent->recycle(top, bytes);
   return result;
 }
 
 egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteBlock(EggProgramStackless& stackless, const std::vector<std::shared_ptr<IEggProgramNode>>& statements) {
   // Create a new context to execute the statements in order
-  return stackless.push<StacklessBlock>(this->allocator, statements).resume(*this);
+  return stackless.push<StacklessBlock>(statements).resume(*this);
 }
 
 egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteDo(EggProgramStackless& stackless, const std::shared_ptr<egg::yolk::IEggProgramNode>& cond, const std::shared_ptr<egg::yolk::IEggProgramNode>& block) {
   // Run in a new context
-  return stackless.push<StacklessDo>(this->allocator, cond, block).resume(*this);
+  return stackless.push<StacklessDo>(cond, block).resume(*this);
 }
 
 egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteFor(EggProgramStackless& stackless, const std::shared_ptr<IEggProgramNode>& pre, const std::shared_ptr<IEggProgramNode>& cond, const std::shared_ptr<IEggProgramNode>& post, const std::shared_ptr<IEggProgramNode>& block) {
   // Run in a new context
-  return stackless.push<StacklessFor>(this->allocator, pre, cond, post, block).resume(*this);
+  return stackless.push<StacklessFor>(pre, cond, post, block).resume(*this);
 }
 
 egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteForeach(EggProgramStackless& stackless, const std::shared_ptr<IEggProgramNode>& lvalue, const std::shared_ptr<IEggProgramNode>& rvalue, const std::shared_ptr<IEggProgramNode>& block) {
@@ -351,7 +391,7 @@ egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteForeach(EggProgramStac
 
 egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteWhile(EggProgramStackless& stackless, const std::shared_ptr<egg::yolk::IEggProgramNode>& cond, const std::shared_ptr<egg::yolk::IEggProgramNode>& block) {
   // Run in a new context
-  return stackless.push<StacklessWhile>(this->allocator, cond, block).resume(*this);
+  return stackless.push<StacklessWhile>(cond, block).resume(*this);
 }
 
 egg::ovum::Variant egg::yolk::EggProgramContext::coexecuteYield(EggProgramStackless&, const std::shared_ptr<IEggProgramNode>& value) {
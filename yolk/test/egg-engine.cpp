@@ -8,11 +8,11 @@
 using namespace egg::yolk;
 
 namespace {
-  std::string logFromEngine(TextStream& stream) {
+  std::string logFromEngine(TextStream& stream, size_t concurrency = 1) {
     egg::test::Allocator allocator;
     auto engine = EggEngineFactory::createEngineFromTextStream(stream);
     auto logger = std::make_shared<egg::test::Logger>();
-    auto preparation = EggEngineFactory::createPreparationContext(allocator, logger);
+    auto preparation = EggEngineFactory::createPreparationContext(allocator, logger, concurrency);
     if (engine->prepare(*preparation) != egg::ovum::ILogger::Severity::Error) {
       auto execution = EggEngineFactory::createExecutionContext(allocator, logger);
       engine->execute(*execution);
@@ -85,6 +85,54 @@ TEST(TestEggEngine, DuplicateSymbols) {
                                            "<COMPILER>(1,5): Previous declaration was here\n");
 }
 
+TEST(TestEggEngine, DeferredFunctionBodies) {
+  // Bodies only see symbols declared before them and diagnostics are reported in source order
+  StringTextStream stream("var x = 1;\n"
+                          "void a() {\n  var x = 2;\n}\n"
+                          "void b() {\n  var a = 1;\n  print(c);\n}\n"
+                          "var c = `c`;\n"
+                          "void d() {\n  var c = 2;\n}\n");
+  ASSERT_EQ("<COMPILER><WARNING>(3,7): Symbol name hides previously declared symbol in enclosing level: 'x'\n"
+            "<COMPILER><WARNING>(6,7): Symbol name hides previously declared symbol in enclosing level: 'a'\n"
+            "<COMPILER><ERROR>(7,9): Unknown identifier: 'c'\n", logFromEngine(stream));
+}
+
+TEST(TestEggEngine, ConcurrentFunctionBodies) {
+  // Enough bodies to be prepared on several threads, each with its own basket, yet logged as if serially
+  std::string source = "var total = 0;\n";
+  for (int i = 0; i < 20; ++i) {
+    auto n = std::to_string(i);
+    source += "int f" + n + "(int x) {\n  var total = x + " + n + ";\n  return total;\n}\n";
+  }
+  for (int i = 0; i < 20; ++i) {
+    source += "total += f" + std::to_string(i) + "(1);\n";
+  }
+  source += "print(total);\n";
+  StringTextStream serial(source);
+  auto expected = logFromEngine(serial, 1);
+  ASSERT_STARTSWITH(expected, "<COMPILER><WARNING>(3,7): Symbol name hides previously declared symbol in enclosing level: 'total'\n");
+  ASSERT_ENDSWITH(expected, "\n210\n");
+  StringTextStream concurrent(source);
+  ASSERT_EQ(expected, logFromEngine(concurrent, 4));
+}
+
+TEST(TestEggEngine, CallDepth) {
+  // Engine users may set a call-depth budget on the execution context
+  egg::test::Allocator allocator;
+  StringTextStream stream("int depth(int n) {\n  if (n == 0) {\n    return 0;\n  }\n  return depth(n - 1) + 1;\n}\nassert(depth(10) == 10);\nprint(depth(500));\n");
+  auto engine = EggEngineFactory::createEngineFromTextStream(stream);
+  auto logger = std::make_shared<egg::test::Logger>();
+  auto preparation = EggEngineFactory::createPreparationContext(allocator, logger);
+  ASSERT_EQ(egg::ovum::ILogger::Severity::None, engine->prepare(*preparation));
+  auto limited = EggEngineFactory::createExecutionContext(allocator, logger, 50);
+  engine->execute(*limited);
+  ASSERT_ENDSWITH(logger->logged.str(), "Maximum call depth of 50 exceeded\n");
+  logger->logged.str("");
+  auto unlimited = EggEngineFactory::createExecutionContext(allocator, logger);
+  ASSERT_EQ(egg::ovum::ILogger::Severity::Information, engine->execute(*unlimited));
+  ASSERT_EQ("500\n", logger->logged.str());
+}
+
 TEST(TestEggEngine, WorkingFile) {
   // TODO still needed?
   egg::test::Allocator allocator;
@@ -32,21 +32,21 @@ namespace {
 }
 
 TEST(TestEggParser, ModuleEmpty) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleParser();
   auto root = parseFromString(allocator, *parser, "");
   ASSERT_PARSE_GOOD(dumpToString(*root), "(module)");
 }
 
 TEST(TestEggParser, ModuleBlock) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleParser();
   auto root = parseFromString(allocator, *parser, "{}");
   ASSERT_PARSE_GOOD(dumpToString(*root), "(module (block))");
 }
 
 TEST(TestEggParser, ModuleSimple) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleParser();
   auto root = parseFromString(allocator, *parser, "var a = b; a = c;");
   ASSERT_PARSE_GOOD(dumpToString(*root), "(module (declare 'a' 'var' (identifier 'b')) (assign '=' (identifier 'a') (identifier 'c')))");
@@ -104,10 +104,18 @@ TEST(TestEggParser, ExpressionType) {
   ASSERT_PARSE_GOOD(typeFromExpression(allocator, "true?123:null"), "int?");
   ASSERT_PARSE_GOOD(typeFromExpression(allocator, "true?123:123.45"), "int|float");
   ASSERT_PARSE_GOOD(typeFromExpression(allocator, "true?123:true?123.45:`hi`"), "int|float|string");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "[1,2,3].length"), "int");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "[1,2,3].sort"), "void(object = null)");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "[1,2,3].sort()"), "void");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "[1,2,3].indexOf(2)"), "any?");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "[1,2,3].unknown"), "any?");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "{a:1}.a"), "any?");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "`hi`.length"), "any?");
+  ASSERT_PARSE_GOOD(typeFromExpression(allocator, "null.length"), "any?");
 }
 
 TEST(TestEggParser, ExampleFile) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   FileTextStream stream("~/yolk/test/data/example.egg");
   auto root = EggParserFactory::parseModule(allocator, stream);
   root->dump(std::cout);
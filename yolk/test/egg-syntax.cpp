@@ -27,7 +27,7 @@ namespace {
     return dumpToString(*root);
   }
   std::string parseExpressionToString(const std::string& text) {
-    egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+    egg::test::Allocator allocator{ egg::test::Allocator::Expectation::Unknown }; // Failing parses may not create a node
     auto parser = EggParserFactory::createExpressionSyntaxParser(allocator);
     auto root = parseFromString(*parser, text);
     return dumpToString(*root);
@@ -45,29 +45,43 @@ namespace {
 }
 
 TEST(TestEggSyntaxParser, SyntaxException) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
   auto lexer = LexerFactory::createFromString("var null", "<string>");
   auto tokenizer = EggTokenizerFactory::createFromLexer(lexer);
   ASSERT_THROW_E(parser->parse(*tokenizer), SyntaxException, expectSyntaxException(e));
 }
 
+TEST(TestEggSyntaxParser, Arena) {
+  // Syntax nodes are bump-allocated from the parser's allocator and only released with the whole tree
+  egg::test::Allocator allocator;
+  auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
+  auto root = parseFromString(*parser, "var a = b + c;");
+  egg::ovum::IAllocator::Statistics stats;
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(1u, stats.currentBlocksAllocated);
+  ASSERT_EQ("(module (declare 'a' (type 'var') (binary '+' (identifier 'b') (identifier 'c'))))", dumpToString(*root));
+  root.reset();
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(0u, stats.currentBlocksAllocated);
+}
+
 TEST(TestEggSyntaxParser, ModuleEmpty) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
   auto root = parseFromString(*parser, "");
   ASSERT_EQ("(module)", dumpToString(*root));
 }
 
 TEST(TestEggSyntaxParser, ModuleOneStatement) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
   auto root = parseFromString(*parser, "var foo;");
   ASSERT_EQ("(module (declare 'foo' (type 'var')))", dumpToString(*root));
 }
 
 TEST(TestEggSyntaxParser, ModuleTwoStatements) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
   auto root = parseFromString(*parser, "var foo;\nvar bar;");
   ASSERT_EQ("(module (declare 'foo' (type 'var')) (declare 'bar' (type 'var')))", dumpToString(*root));
@@ -171,6 +185,9 @@ TEST(TestEggSyntaxParser, ExpressionBinary) {
   ASSERT_PARSE_GOOD(parseExpressionToString("a - b + c"), "(binary '+' (binary '-' (identifier 'a') (identifier 'b')) (identifier 'c'))");
   ASSERT_PARSE_GOOD(parseExpressionToString("a * b + c"), "(binary '+' (binary '*' (identifier 'a') (identifier 'b')) (identifier 'c'))");
   ASSERT_PARSE_GOOD(parseExpressionToString("a + b * c"), "(binary '+' (identifier 'a') (binary '*' (identifier 'b') (identifier 'c')))");
+  ASSERT_PARSE_GOOD(parseExpressionToString("a || b && c | d"), "(binary '||' (identifier 'a') (binary '&&' (identifier 'b') (binary '|' (identifier 'c') (identifier 'd'))))");
+  ASSERT_PARSE_GOOD(parseExpressionToString("a == b < c << d"), "(binary '==' (identifier 'a') (binary '<' (identifier 'b') (binary '<<' (identifier 'c') (identifier 'd'))))");
+  ASSERT_PARSE_GOOD(parseExpressionToString("a * b == c ^ d & e"), "(binary '^' (binary '==' (binary '*' (identifier 'a') (identifier 'b')) (identifier 'c')) (binary '&' (identifier 'd') (identifier 'e')))");
   // Bad
   ASSERT_PARSE_BAD(parseExpressionToString("a +"), "(1, 4): Expected expression after infix '+' operator");
   ASSERT_PARSE_BAD(parseExpressionToString("++a"), "(1, 1): Expression expected, not operator: '++'");
@@ -293,6 +310,9 @@ TEST(TestEggSyntaxParser, StatementFor) {
   ASSERT_PARSE_GOOD(parseStatementToString("for (a : b) {}"), "(foreach (identifier 'a') (identifier 'b') (block))");
   ASSERT_PARSE_GOOD(parseStatementToString("for (*a : b) {}"), "(foreach (unary '*' (identifier 'a')) (identifier 'b') (block))");
   ASSERT_PARSE_GOOD(parseStatementToString("for (var a : b) {}"), "(foreach (declare 'a' (type 'var')) (identifier 'b') (block))");
+  ASSERT_PARSE_GOOD(parseStatementToString("for (a : b ? c : d) {}"), "(foreach (identifier 'a') (ternary (identifier 'b') (identifier 'c') (identifier 'd')) (block))");
+  ASSERT_PARSE_GOOD(parseStatementToString("for (a = b ? c : d;;) {}"), "(for (assign '=' (identifier 'a') (ternary (identifier 'b') (identifier 'c') (identifier 'd'))) () () (block))");
+  ASSERT_PARSE_GOOD(parseStatementToString("for (a = f(b: c);;) {}"), "(for (assign '=' (identifier 'a') (call (identifier 'f') (named 'b' (identifier 'c')))) () () (block))");
   // Bad
   ASSERT_PARSE_BAD(parseStatementToString("for {"), "(1, 5): Expected '(' after 'for' keyword");
   ASSERT_PARSE_BAD(parseStatementToString("for ("), "(1, 6): Expected simple statement after '(' in 'for' statement");
@@ -449,10 +469,49 @@ TEST(TestEggSyntaxParser, Vexatious) {
   ASSERT_PARSE_GOOD(parseExpressionToString("a--1"), "(binary '-' (identifier 'a') (literal int -1))");
   ASSERT_PARSE_GOOD(parseExpressionToString("a-1"), "(binary '-' (identifier 'a') (literal int 1))");
   ASSERT_PARSE_GOOD(parseExpressionToString("a-- 1"), "(binary '-' (identifier 'a') (unary '-' (literal int 1)))");
+  ASSERT_PARSE_GOOD(parseExpressionToString("a--b*c"), "(binary '-' (identifier 'a') (binary '*' (unary '-' (identifier 'b')) (identifier 'c')))");
+}
+
+TEST(TestEggSyntaxParser, Pathological) {
+  // Long operator chains and deep nesting should parse in time linear in the number of tokens
+  const size_t count = 2000;
+  std::string chain = "a";
+  for (size_t i = 0; i < count; ++i) {
+    chain += (i & 1) ? " * a" : " + a";
+  }
+  ASSERT_STARTSWITH(parseExpressionToString(chain), "(binary '+' (binary '+' ");
+  std::string nested = std::string(count / 10, '(') + "a" + std::string(count / 10, ')');
+  ASSERT_PARSE_GOOD(parseExpressionToString(nested), "(identifier 'a')");
+  ASSERT_PARSE_GOOD(parseStatementToString("int x = " + nested + ";"), "(declare 'x' (type 'int') (identifier 'a'))");
+  // Statements starting with parenthesized expressions or types used to parse partially and then rewind
+  std::string parens = std::string(count / 10, '(');
+  std::string closes = std::string(count / 10, ')');
+  ASSERT_PARSE_GOOD(parseStatementToString(parens + "void|int" + closes + " x;"), "(declare 'x' (type 'void|int'))");
+  auto allocated = [&](size_t statements, std::string& dump) {
+    // Discarded partial parses still carve their nodes from the tree's arena, so allocations measure the work done
+    std::string module;
+    for (size_t i = 0; i < statements; ++i) {
+      module += (i & 1) ? parens + "a" + closes + " = b;\n" : parens + "int|string" + closes + "? x = " + chain + ";\n";
+    }
+    egg::test::Allocator allocator;
+    auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
+    auto root = parseFromString(*parser, module);
+    dump = dumpToString(*root);
+    egg::ovum::IAllocator::Statistics stats;
+    allocator.statistics(stats);
+    return stats.totalBytesAllocated;
+  };
+  // Doubling the input must no more than double the work
+  std::string dump;
+  auto small = allocated(count / 20, dump);
+  auto large = allocated(count / 10, dump);
+  ASSERT_STARTSWITH(dump, "(module (declare 'x' (type 'int|string?') (binary '+' ");
+  ASSERT_GT(large, small);
+  ASSERT_LE(large, 2 * small);
 }
 
 TEST(TestEggSyntaxParser, ExampleFile) {
-  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations }; // TODO
+  egg::test::Allocator allocator;
   auto lexer = LexerFactory::createFromPath("~/yolk/test/data/example.egg");
   auto tokenizer = EggTokenizerFactory::createFromLexer(lexer);
   auto parser = EggParserFactory::createModuleSyntaxParser(allocator);
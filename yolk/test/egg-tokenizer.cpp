@@ -4,6 +4,9 @@
 
 using namespace egg::yolk;
 
+#define EGG_TOKENIZER_KEYWORD_ROUNDTRIP(key, text) EggTokenizerKeyword::key,
+#define EGG_TOKENIZER_OPERATOR_ROUNDTRIP(key, text) EggTokenizerOperator::key,
+
 namespace {
   std::shared_ptr<IEggTokenizer> createFromString(const std::string& text) {
     auto lexer = LexerFactory::createFromString(text);
@@ -54,6 +57,25 @@ TEST(TestEggTokenizer, TryParseOperator) {
   ASSERT_FALSE(EggTokenizerValue::tryParseOperator("@", op, length));
 }
 
+TEST(TestEggTokenizer, TryParseRoundTrip) {
+  EggTokenizerKeyword keyword = EggTokenizerKeyword::Null;
+  for (auto expected : { EGG_TOKENIZER_KEYWORDS(EGG_TOKENIZER_KEYWORD_ROUNDTRIP) }) {
+    ASSERT_TRUE(EggTokenizerValue::tryParseKeyword(EggTokenizerValue::getKeywordString(expected), keyword));
+    ASSERT_EQ(keyword, expected);
+  }
+  EggTokenizerOperator op = EggTokenizerOperator::Bang;
+  size_t length = 0;
+  for (auto expected : { EGG_TOKENIZER_OPERATORS(EGG_TOKENIZER_OPERATOR_ROUNDTRIP) }) {
+    auto text = EggTokenizerValue::getOperatorString(expected);
+    ASSERT_TRUE(EggTokenizerValue::tryParseOperator(text + "x", op, length));
+    ASSERT_EQ(op, expected);
+    ASSERT_EQ(length, text.size());
+  }
+  ASSERT_FALSE(EggTokenizerValue::tryParseKeyword("tru", keyword));
+  ASSERT_FALSE(EggTokenizerValue::tryParseKeyword("yields", keyword));
+  ASSERT_FALSE(EggTokenizerValue::tryParseKeyword("Any", keyword));
+}
+
 TEST(TestEggTokenizer, EmptyFile) {
   EggTokenizerItem item;
   auto tokenizer = createFromString("");
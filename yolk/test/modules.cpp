@@ -6,6 +6,8 @@
 #include "yolk/egg-engine.h"
 #include "yolk/egg-program.h"
 
+#include <thread>
+
 using namespace egg::yolk;
 
 namespace {
@@ -61,9 +63,212 @@ TEST(TestModules, Coverage) {
   ASSERT_STARTSWITH(retval, "[A3 67 67 56 4D 00 ");
 }
 
+TEST(TestModules, CompileBatch) {
+  // Concurrent batch compilation must be indistinguishable from serial compilation
+  auto paths = EggEngineFactory::findSourceFiles("~/examples");
+  ASSERT_GT(paths.size(), 50u);
+  ASSERT_TRUE(std::is_sorted(paths.begin(), paths.end()));
+  std::vector<EggEngineBatchResult> serial;
+  auto expected = EggEngineFactory::compileBatch(paths, serial, 1);
+  std::vector<EggEngineBatchResult> parallel;
+  ASSERT_EQ(expected, EggEngineFactory::compileBatch(paths, parallel, 4));
+  ASSERT_EQ(paths.size(), parallel.size());
+  for (size_t index = 0; index < paths.size(); ++index) {
+    ASSERT_EQ(paths[index], parallel[index].path);
+    ASSERT_EQ(serial[index].severity, parallel[index].severity);
+    ASSERT_EQ(serial[index].diagnostics, parallel[index].diagnostics);
+    ASSERT_EQ(serial[index].module, parallel[index].module);
+    ASSERT_NE(parallel[index].severity == egg::ovum::ILogger::Severity::Error, !parallel[index].module.empty());
+  }
+}
+
+TEST(TestModules, CompileBatchMissing) {
+  std::vector<EggEngineBatchResult> results;
+  ASSERT_EQ(egg::ovum::ILogger::Severity::Error, EggEngineFactory::compileBatch({ "~/examples/missing.egg" }, results));
+  ASSERT_EQ(1u, results.size());
+  ASSERT_STARTSWITH(results[0].diagnostics, "<ERROR>");
+  ASSERT_TRUE(results[0].module.empty());
+}
+
 TEST(TestModules, Compiler) {
   egg::test::Allocator allocator;
   egg::test::Logger logger;
   auto actual = egg::test::Compiler::run(allocator, logger, "~/yolk/test/data/coverage.egg");
   ASSERT_EQ("<void>", actual.toString().toUTF8());
 }
+
+TEST(TestModules, FrozenThreads) {
+  // Execute a single frozen module concurrently with per-thread programs; functions hold handles on the shared tree
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int add(int a, int b) {\n  return a + b;\n}\nvar total = 0;\nfor (var i = 0; i < 1000; ++i) {\n  total = add(total, i);\n}\nassert(total == 499500);\n");
+  ASSERT_NE(nullptr, compiled);
+  auto module = egg::ovum::ModuleFactory::fromRootNode(allocator, "<frozen>", compiled->getRootNode(), egg::ovum::ModuleFactory::Sharing::Frozen);
+  ASSERT_NE(nullptr, module);
+  ASSERT_TRUE(module->getRootNode().isFrozen());
+  const size_t threads = 4;
+  std::vector<std::string> results(threads);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&module, &results, t]() {
+      egg::test::Allocator local;
+      egg::test::Logger discard;
+      auto program = egg::ovum::ProgramFactory::createProgram(local, discard);
+      results[t] = program->run(*module).toString().toUTF8() + discard.logged.str();
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  for (auto& result : results) {
+    ASSERT_EQ("<void>", result);
+  }
+}
+
+TEST(TestModules, TailCalls) {
+  // Calls in tail position reuse the caller's frame so they don't count towards the depth budget
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int sum(int n, int acc) {\n  if (n == 0) {\n    return acc;\n  }\n  return sum(n - 1, acc + n);\n}\nassert(sum(100000, 0) == 5000050000);\n");
+  ASSERT_NE(nullptr, compiled);
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger, 10);
+  ASSERT_EQ("<void>", program->run(*compiled).toString().toUTF8());
+  ASSERT_EQ("", logger.logged.str());
+}
+
+TEST(TestModules, CallDepth) {
+  // Other recursion is limited by the depth budget
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int depth(int n) {\n  if (n == 0) {\n    return 0;\n  }\n  return depth(n - 1) + 1;\n}\nassert(depth(10) == 10);\nprint(depth(500));\n");
+  ASSERT_NE(nullptr, compiled);
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger, 50);
+  auto result = program->run(*compiled);
+  ASSERT_TRUE(result.stripFlowControl(egg::ovum::VariantBits::Throw));
+  ASSERT_STRING("(5,18): Maximum call depth of 50 exceeded", result.toString());
+  // There is no budget unless the embedder asks for one
+  program = egg::ovum::ProgramFactory::createProgram(allocator, logger);
+  result = program->run(*compiled);
+  ASSERT_EQ("<void>", result.toString().toUTF8());
+  ASSERT_EQ("500\n", logger.logged.str());
+}
+
+TEST(TestModules, Generators) {
+  // Generators suspend within nested blocks, 'if' statements and loops
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger,
+    "int... evens(int limit) {\n"
+    "  var i = 0;\n"
+    "  while (true) {\n"
+    "    i = i + 1;\n"
+    "    if (i > limit) {\n"
+    "      break;\n"
+    "    }\n"
+    "    if (i % 2 != 0) {\n"
+    "      continue;\n"
+    "    }\n"
+    "    yield i;\n"
+    "  }\n"
+    "}\n"
+    "int... pairs(int n) {\n"
+    "  for (var a = 1; a <= n; ++a) {\n"
+    "    yield a * 10;\n"
+    "    if (a == n) {\n"
+    "      yield 0;\n"
+    "    } else {\n"
+    "      yield a;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "assert(type.of(evens(1)) == \"int...\");\n"
+    "for (var e : evens(9)) {\n"
+    "  print(e);\n"
+    "}\n"
+    "var g = pairs(2);\n"
+    "while (var p = g()) {\n"
+    "  print(p);\n"
+    "}\n"
+    "print(g());\n");
+  ASSERT_NE(nullptr, compiled);
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger);
+  ASSERT_EQ("<void>", program->run(*compiled).toString().toUTF8());
+  ASSERT_EQ("2\n4\n6\n8\n10\n1\n20\n0\n<void>\n", logger.logged.str());
+}
+
+TEST(TestModules, GeneratorsUnyieldable) {
+  // Generators cannot resume within these statements, so the compiler rejects them
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int... g() {\n  switch (1) {\n    default:\n      yield 1;\n      break;\n  }\n}\n");
+  ASSERT_EQ(nullptr, compiled);
+  compiled = egg::test::Compiler::compileText(allocator, logger, "int... g() {\n  try {\n    yield 1;\n  } catch (any e) {\n  }\n}\n");
+  ASSERT_EQ(nullptr, compiled);
+  compiled = egg::test::Compiler::compileText(allocator, logger, "int... g() {\n  for (var i : [1]) {\n    yield i;\n  }\n}\n");
+  ASSERT_EQ(nullptr, compiled);
+  ASSERT_EQ("<COMPILER><ERROR>(4,7): The 'yield' statement is not supported within 'switch' statements of generators\n"
+            "<COMPILER><ERROR>(3,5): The 'yield' statement is not supported within 'try' statements of generators\n"
+            "<COMPILER><ERROR>(3,5): The 'yield' statement is not supported within 'for-each' statements of generators\n", logger.logged.str());
+}
+
+TEST(TestModules, Locations) {
+  // Source locations are only resolved when an error is raised
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int f(int x) {\n  return x;\n}\nvar a = f(1);\nprint(f(a), f(\"two\"));\n");
+  ASSERT_NE(nullptr, compiled);
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger);
+  auto result = program->run(*compiled);
+  ASSERT_TRUE(result.stripFlowControl(egg::ovum::VariantBits::Throw));
+  ASSERT_STRING("(5,15): Type mismatch for parameter 'x': Expected 'int', but got 'string' instead", result.toString());
+  compiled = egg::test::Compiler::compileText(allocator, logger, "int f(int x) {\n  return x;\n}\nassert(f(1) + f(2) == 0);\n");
+  ASSERT_NE(nullptr, compiled);
+  result = program->run(*compiled);
+  ASSERT_TRUE(result.stripFlowControl(egg::ovum::VariantBits::Throw));
+  ASSERT_STRING("(4,20): Assertion is untrue: 3 == 0", result.toString());
+}
+
+TEST(TestModules, TypeProofs) {
+  // The compiler marks assignments whose types are proven so that the runtime can skip the check
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int a = 1;\nfloat b = a;\na = 3 * 2 + 1;\nany c = a;\nstring d = c;\nvar e = !(a < 3);\n");
+  ASSERT_NE(nullptr, compiled);
+  ASSERT_EQ(6u, compiled->getRootNode().getChild(0).getChildren());
+  auto proven = [&](size_t index) {
+    auto& statement = compiled->getRootNode().getChild(0).getChild(index);
+    return (statement.getAttributes() == 1) && statement.getAttribute(0).getChild(0).getString().equals(egg::ovum::Node::AttributeProven);
+  };
+  ASSERT_TRUE(proven(0)); // int a = 1
+  ASSERT_FALSE(proven(1)); // promotion to float
+  ASSERT_TRUE(proven(2)); // int arithmetic
+  ASSERT_FALSE(proven(3)); // identifiers may be uninitialized
+  ASSERT_FALSE(proven(4)); // any to string
+  ASSERT_TRUE(proven(5)); // bool
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger);
+  auto result = program->run(*compiled);
+  ASSERT_TRUE(result.stripFlowControl(egg::ovum::VariantBits::Throw));
+  ASSERT_STRING("(5,8): Cannot assign a value of type 'int' to a target of type 'string'", result.toString());
+  // Variables declared without an initializer are still checked when read
+  compiled = egg::test::Compiler::compileText(allocator, logger, "int a;\nint b = a;\nprint(b);\n");
+  ASSERT_NE(nullptr, compiled);
+  ASSERT_FALSE(proven(1));
+  result = program->run(*compiled);
+  ASSERT_TRUE(result.stripFlowControl(egg::ovum::VariantBits::Throw));
+  ASSERT_STRING("(2,5): Cannot assign a value of type 'void' to a target of type 'int'", result.toString());
+}
+
+TEST(TestModules, TypeProofsChecked) {
+  // Programs may distrust the compiler's type proofs, so a wrong proof raises the usual type error
+  egg::test::Allocator allocator;
+  egg::test::Logger logger;
+  auto compiled = egg::test::Compiler::compileText(allocator, logger, "int a = 1;\na = 2;\n");
+  ASSERT_NE(nullptr, compiled);
+  auto& statement = compiled->getRootNode().getChild(0).getChild(1);
+  ASSERT_EQ(1u, statement.getAttributes());
+  statement.setChild(1, *egg::ovum::NodeFactory::createValue(allocator, egg::ovum::String("two")));
+  auto program = egg::ovum::ProgramFactory::createProgram(allocator, logger, egg::ovum::ProgramFactory::UnlimitedCallDepth, egg::ovum::ProgramFactory::Proofs::Checked);
+  auto result = program->run(*compiled);
+  ASSERT_TRUE(result.stripFlowControl(egg::ovum::VariantBits::Throw));
+  ASSERT_STRING("(2,3): Cannot assign a value of type 'string' to a target of type 'int'", result.toString());
+}
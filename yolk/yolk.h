@@ -21,7 +21,9 @@
 #include "ovum/node.h"
 #include "ovum/module.h"
 #include "ovum/program.h"
+#include "ovum/optimizer.h"
 #include "ovum/dictionary.h"
+#include "ovum/packed.h"
 #include "ovum/function.h"
 
 #include "yolk/macros.h"